@@ -0,0 +1,195 @@
+/**
+ * @file batch.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación del modo por lotes.
+ */
+
+#include "batch.h"
+#include "point_reader.h"
+#include "point_file.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace EMST
+{
+    /**
+     * @brief Carga los conjuntos desde stdin, un fichero o un directorio.
+     * @param path fichero, directorio o cadena vacía
+     * @param sets conjuntos leídos
+     * @param error mensaje de error (salida)
+     * @return true si la lectura fue correcta
+     */
+    bool load_batch(const std::string &path, std::vector<CyA::point_vector> &sets, std::string &error)
+    {
+        sets.clear();
+
+        if (path.empty())
+        {
+            return read_point_sets(0, sets, error);
+        }
+
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+        {
+            if (is_point_file(path))
+            {
+                mapped_point_file mapped;
+                if (!mapped.open(path, error))
+                {
+                    return false;
+                }
+
+                sets.emplace_back();
+                mapped.read(sets.back());
+                return true;
+            }
+
+            // Fichero de texto con conjuntos concatenados
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                error = path + ": " + std::strerror(errno);
+                return false;
+            }
+
+            const bool ok = read_point_sets(fd, sets, error);
+            ::close(fd);
+            return ok;
+        }
+
+        // Directorio: un conjunto por fichero regular, en orden alfabético
+        DIR *dir = opendir(path.c_str());
+        if (dir == nullptr)
+        {
+            error = path + ": no se puede abrir el directorio";
+            return false;
+        }
+
+        std::vector<std::string> files;
+        for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+        {
+            const std::string file = path + "/" + entry->d_name;
+
+            struct stat fst;
+            if (stat(file.c_str(), &fst) == 0 && S_ISREG(fst.st_mode))
+            {
+                files.push_back(file);
+            }
+        }
+        closedir(dir);
+
+        std::sort(files.begin(), files.end());
+
+        for (const std::string &file : files)
+        {
+            sets.emplace_back();
+
+            bool ok;
+            if (is_point_file(file))
+            {
+                mapped_point_file mapped;
+                ok = mapped.open(file, error);
+                if (ok)
+                {
+                    mapped.read(sets.back());
+                }
+            }
+            else
+            {
+                ok = read_points(file, sets.back(), error);
+                if (!ok)
+                {
+                    error = file + ": " + error;
+                }
+            }
+
+            if (!ok)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Reparte los conjuntos entre los hilos y escribe los resultados en orden.
+     * @param sets conjuntos de puntos
+     * @param e motor EMST
+     * @param workers número de hilos
+     * @param out destino
+     */
+    void solve_batch(std::vector<CyA::point_vector> &sets, engine e, int workers, output_writer &out)
+    {
+        const size_t m = sets.size();
+
+        std::vector<std::string> results(m);
+        std::vector<char> ready(m, 0);
+        std::mutex mutex;
+        std::condition_variable done;
+        std::atomic<size_t> next(0);
+
+        workers = std::max(1, std::min(workers, static_cast<int>(std::max<size_t>(m, 1))));
+
+        // Cada hilo toma el siguiente conjunto libre y reutiliza su point_set
+        auto work = [&]() {
+            point_set ps(CyA::point_vector{});
+
+            for (size_t k = next++; k < m; k = next++)
+            {
+                ps.reset(std::move(sets[k]));
+                ps.EMST(e);
+
+                std::string text;
+                {
+                    output_writer writer(text);
+                    ps.write_tree(writer);
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    results[k].swap(text);
+                    ready[k] = 1;
+                }
+                done.notify_one();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (int w = 0; w < workers; ++w)
+        {
+            pool.emplace_back(work);
+        }
+
+        // Escribir en orden de entrada según van terminando
+        for (size_t k = 0; k < m; ++k)
+        {
+            std::string text;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                done.wait(lock, [&]() { return ready[k] != 0; });
+                text.swap(results[k]);
+            }
+
+            out.put(text.c_str());
+        }
+
+        for (std::thread &t : pool)
+        {
+            t.join();
+        }
+    }
+}
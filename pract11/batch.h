@@ -0,0 +1,43 @@
+/**
+ * @file batch.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Modo por lotes: muchos conjuntos de puntos resueltos en un grupo fijo de hilos.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "point_types.h"
+#include "point_set.h"
+#include "output_writer.h"
+
+namespace EMST
+{
+    /**
+     * @brief Carga los conjuntos de un lote.
+     *
+     * Si path es un directorio cada fichero regular (en orden alfabético) es un
+     * conjunto, de texto o binario; si es un fichero, o vacío para stdin, se leen
+     * conjuntos "n / x y" concatenados.
+     * @param path fichero, directorio o cadena vacía (stdin)
+     * @param sets conjuntos leídos
+     * @param error mensaje de error (salida)
+     * @return true si la lectura fue correcta
+     */
+    bool load_batch(const std::string &path, std::vector<CyA::point_vector> &sets, std::string &error);
+
+    /**
+     * @brief Resuelve todos los conjuntos con workers hilos y escribe los resultados en orden.
+     *
+     * Cada hilo reutiliza su propio point_set (y sus búferes) para todos los
+     * conjuntos que procesa; la salida de cada conjunto es la de write_tree y se
+     * vuelca en el orden de entrada en cuanto está disponible.
+     * @param sets conjuntos de puntos (se vacían al procesarse)
+     * @param e motor EMST
+     * @param workers número de hilos
+     * @param out destino de los resultados
+     */
+    void solve_batch(std::vector<CyA::point_vector> &sets, engine e, int workers, output_writer &out);
+}
@@ -0,0 +1,759 @@
+/**
+ * @file bench.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Banco de pruebas: mide point_set::EMST por motor, distribución y tamaño.
+ *
+ * Uso:
+ *   ./emst_bench # todas las distribuciones y motores, n = 10²..10⁷, 3 repeticiones
+ *   ./emst_bench -a delaunay,boruvka --max 5 # solo hasta 10⁵ puntos
+ *   ./emst_bench -g uniform,grid -r 5 -f json # salida JSON (un objeto por línea)
+ *   ./emst_bench -j 8 --quadratic-limit 50000 # más hilos y más n para los motores O(n²)
+ *   ./emst_bench -a delaunay --approx 0.1,0.5,1 # EMST aproximado frente al exacto
+ *   ./emst_bench -a delaunay --latency 500 --points 1000 # latencia: un proceso por petición frente a --serve
+ *   ./emst_bench -g uniform --forest --max 6 # reservas de build_forest con el heap y con un pool
+ *
+ * Cada fila es una repetición: distribución, motor, n, repetición, hilos,
+ * segundos de EMST (sin contar la generación ni la copia de los puntos), coste
+ * y las fases de emst_stats: segundos de detección de repetidos, generación de
+ * aristas, ordenación y recorrido, aristas generadas, búsquedas y uniones. Los
+ * motores O(n²) se omiten por encima de --quadratic-limit puntos.
+ * Las filas del motor aproximado se llaman "approx-ε"; su coste se compara con
+ * el de cualquier motor exacto de la misma distribución y n.
+ *
+ * Con --latency se mide en cambio la latencia de extremo a extremo de
+ * peticiones pequeñas lanzadas contra el ejecutable emst (--emst): un proceso
+ * por petición frente a un servidor --serve ya arrancado. Cada fila da la
+ * distribución, el motor, el modo (process o server), n, el número de
+ * peticiones y los percentiles 50 y 99 en milisegundos.
+ *
+ * Con --forest se mide point_set::build_forest sobre el EMST de Delaunay con
+ * los puntos de los sub_trees en el heap y en un unsynchronized_pool_resource:
+ * segundos, número de reservas pedidas al sistema, bytes y coste del bosque.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <memory_resource>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "point_types.h"
+#include "point_set.h"
+#include "point_generator.h"
+#include "output_writer.h"
+#include "server.h"
+#include "sub_tree.h"
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace EMST;
+
+// Aristas estimadas a partir de las cuales se omite el motor aproximado (~800 MB)
+#define APPROX_EDGE_LIMIT 50000000.0
+
+/**
+ * @brief Imprime la línea de uso del banco de pruebas.
+ * @param os flujo de salida
+ * @param program nombre del ejecutable
+ */
+static void usage(ostream &os, const char *program)
+{
+    os << "Uso: " << program << " [-a motor,...] [-g distribución,...] [--min exp] [--max exp]"
+       << " [-r repeticiones] [-j hilos] [-f csv|json] [--quadratic-limit n] [--approx eps,...]"
+       << " [--latency peticiones] [--points n] [--emst ejecutable] [--forest]" << endl;
+}
+
+/**
+ * @brief Divide una lista separada por comas.
+ * @param list texto "a,b,c"
+ * @return elementos no vacíos
+ */
+static vector<string> split(const string &list)
+{
+    vector<string> items;
+    stringstream ss(list);
+    string item;
+
+    while (getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+
+    return items;
+}
+
+/**
+ * @brief Indica si el motor genera o recorre las n² parejas de puntos.
+ * @param e motor
+ * @return true para kruskal, filter y prim
+ */
+static bool is_quadratic(engine e)
+{
+    return e == engine::kruskal || e == engine::filter || e == engine::prim;
+}
+
+/**
+ * @brief Escribe una fila de resultados en CSV o JSON.
+ * @param out destino
+ * @param json true para JSON (un objeto por línea)
+ * @param distribution nombre de la distribución
+ * @param engine nombre del motor
+ * @param n número de puntos
+ * @param rep número de repetición
+ * @param threads hilos
+ * @param seconds segundos de EMST
+ * @param cost coste del árbol
+ * @param stats fases y contadores de la ejecución
+ */
+static void write_row(output_writer &out, bool json, const char *distribution, const string &engine,
+                      size_t n, int rep, int threads, double seconds, double cost, const emst_stats &stats)
+{
+    if (json)
+    {
+        out.put("{\"distribution\":\"");
+        out.put(distribution);
+        out.put("\",\"engine\":\"");
+        out.put(engine.c_str());
+        out.put("\",\"n\":");
+        out.put(static_cast<unsigned long long>(n));
+        out.put(",\"rep\":");
+        out.put(static_cast<unsigned long long>(rep));
+        out.put(",\"threads\":");
+        out.put(static_cast<unsigned long long>(threads));
+        out.put(",\"seconds\":");
+        out.put_general(seconds);
+        out.put(",\"cost\":");
+        out.put_fixed(cost, 0, 6);
+        out.put(",\"dedup_seconds\":");
+        out.put_general(stats.dedup_seconds);
+        out.put(",\"generate_seconds\":");
+        out.put_general(stats.generate_seconds);
+        out.put(",\"sort_seconds\":");
+        out.put_general(stats.sort_seconds);
+        out.put(",\"mst_seconds\":");
+        out.put_general(stats.mst_seconds);
+        out.put(",\"edges_generated\":");
+        out.put(static_cast<unsigned long long>(stats.edges_generated));
+        out.put(",\"finds\":");
+        out.put(static_cast<unsigned long long>(stats.finds));
+        out.put(",\"unions\":");
+        out.put(static_cast<unsigned long long>(stats.unions));
+        out.put("}\n");
+    }
+    else
+    {
+        out.put(distribution);
+        out.put(',');
+        out.put(engine.c_str());
+        out.put(',');
+        out.put(static_cast<unsigned long long>(n));
+        out.put(',');
+        out.put(static_cast<unsigned long long>(rep));
+        out.put(',');
+        out.put(static_cast<unsigned long long>(threads));
+        out.put(',');
+        out.put_general(seconds);
+        out.put(',');
+        out.put_fixed(cost, 0, 6);
+        out.put(',');
+        out.put_general(stats.dedup_seconds);
+        out.put(',');
+        out.put_general(stats.generate_seconds);
+        out.put(',');
+        out.put_general(stats.sort_seconds);
+        out.put(',');
+        out.put_general(stats.mst_seconds);
+        out.put(',');
+        out.put(static_cast<unsigned long long>(stats.edges_generated));
+        out.put(',');
+        out.put(static_cast<unsigned long long>(stats.finds));
+        out.put(',');
+        out.put(static_cast<unsigned long long>(stats.unions));
+        out.put('\n');
+    }
+}
+
+/**
+ * @brief Percentil q (0..1) de un vector ordenado (método del rango más cercano).
+ * @param sorted valores ordenados
+ * @param q percentil
+ * @return valor
+ */
+static double percentile(const vector<double> &sorted, double q)
+{
+    const size_t rank = static_cast<size_t>(ceil(q * sorted.size()));
+
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+ * @brief Ejecuta "emst args..." con request por stdin y devuelve su salida completa.
+ * @param program ejecutable emst
+ * @param args argumentos
+ * @param request entrada
+ * @param response salida del proceso
+ * @return true si el proceso terminó con estado 0
+ */
+static bool run_process(const string &program, const vector<string> &args, const string &request, string &response)
+{
+    int in[2];
+    int out[2];
+    if (pipe(in) != 0 || pipe(out) != 0)
+    {
+        return false;
+    }
+
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+        dup2(in[0], 0);
+        dup2(out[1], 1);
+        close(in[0]);
+        close(in[1]);
+        close(out[0]);
+        close(out[1]);
+
+        vector<char *> argv;
+        argv.push_back(const_cast<char *>(program.c_str()));
+        for (const string &a : args)
+        {
+            argv.push_back(const_cast<char *>(a.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        execv(program.c_str(), argv.data());
+        _exit(127);
+    }
+
+    close(in[0]);
+    close(out[1]);
+
+    // emst lee toda la entrada antes de escribir: primero se envía, después se lee
+    bool ok = pid > 0;
+    for (size_t sent = 0; ok && sent < request.size();)
+    {
+        const ssize_t w = write(in[1], request.data() + sent, request.size() - sent);
+        if (w < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        ok = w > 0;
+        sent += ok ? static_cast<size_t>(w) : 0;
+    }
+    close(in[1]);
+
+    response.clear();
+    char chunk[1 << 16];
+    for (;;)
+    {
+        const ssize_t r = read(out[0], chunk, sizeof(chunk));
+        if (r < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (r <= 0)
+        {
+            break;
+        }
+        response.append(chunk, static_cast<size_t>(r));
+    }
+    close(out[0]);
+
+    int status = 0;
+    if (pid > 0)
+    {
+        waitpid(pid, &status, 0);
+    }
+
+    return ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * @brief Latencia de un proceso por petición frente a un servidor --serve.
+ * @param out destino
+ * @param json true para JSON
+ * @param program ejecutable emst
+ * @param d distribución
+ * @param name nombre del motor
+ * @param n puntos por petición
+ * @param requests número de peticiones por modo
+ * @param threads hilos del servidor
+ * @return false si algún modo falló
+ */
+static bool measure_latency(output_writer &out, bool json, const string &program, distribution d,
+                            const string &name, size_t n, int requests, int threads)
+{
+    CyA::point_vector points;
+    generate_points(d, n, 1000003u * n + static_cast<unsigned>(d), points);
+
+    string request;
+    {
+        output_writer text(request);
+        text.put(static_cast<unsigned long long>(n));
+        text.put('\n');
+        for (const CyA::point &p : points)
+        {
+            text.put_fixed(p.first, 0, 6);
+            text.put(' ');
+            text.put_fixed(p.second, 0, 6);
+            text.put('\n');
+        }
+    }
+
+    const string socket_path = "/tmp/emst-bench-" + to_string(getpid()) + ".sock";
+    const pid_t server = fork();
+    if (server == 0)
+    {
+        const int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, 1);
+        execl(program.c_str(), program.c_str(), "--serve", socket_path.c_str(), "-a", name.c_str(),
+              "-j", to_string(threads).c_str(), static_cast<char *>(nullptr));
+        _exit(127);
+    }
+
+    // Esperar a que el servidor acepte conexiones (como mucho ~5 s)
+    string response;
+    string error;
+    bool ready = false;
+    for (int attempt = 0; attempt < 500 && !ready && server > 0; ++attempt)
+    {
+        ready = send_request(socket_path, "1\n0 0\n", response, error);
+        if (!ready)
+        {
+            usleep(10000);
+        }
+    }
+
+    string expected;
+    bool ok = ready;
+    const vector<string> args = {"-a", name};
+
+    for (int mode = 0; mode < 2 && ok; ++mode)
+    {
+        vector<double> millis;
+        millis.reserve(requests);
+
+        for (int r = 0; r < requests && ok; ++r)
+        {
+            const auto start = chrono::steady_clock::now();
+            ok = mode == 0 ? run_process(program, args, request, response)
+                           : send_request(socket_path, request, response, error);
+            const auto stop = chrono::steady_clock::now();
+
+            millis.push_back(chrono::duration<double, milli>(stop - start).count());
+
+            // Ambos modos deben devolver exactamente la misma salida
+            if (expected.empty())
+            {
+                expected = response;
+            }
+            ok = ok && response == expected;
+        }
+
+        if (!ok)
+        {
+            break;
+        }
+
+        sort(millis.begin(), millis.end());
+        const char *mode_name = mode == 0 ? "process" : "server";
+
+        if (json)
+        {
+            out.put("{\"distribution\":\"");
+            out.put(distribution_name(d));
+            out.put("\",\"engine\":\"");
+            out.put(name.c_str());
+            out.put("\",\"mode\":\"");
+            out.put(mode_name);
+            out.put("\",\"n\":");
+            out.put(static_cast<unsigned long long>(n));
+            out.put(",\"requests\":");
+            out.put(static_cast<unsigned long long>(requests));
+            out.put(",\"p50_ms\":");
+            out.put_fixed(percentile(millis, 0.50), 0, 3);
+            out.put(",\"p99_ms\":");
+            out.put_fixed(percentile(millis, 0.99), 0, 3);
+            out.put("}\n");
+        }
+        else
+        {
+            out.put(distribution_name(d));
+            out.put(',');
+            out.put(name.c_str());
+            out.put(',');
+            out.put(mode_name);
+            out.put(',');
+            out.put(static_cast<unsigned long long>(n));
+            out.put(',');
+            out.put(static_cast<unsigned long long>(requests));
+            out.put(',');
+            out.put_fixed(percentile(millis, 0.50), 0, 3);
+            out.put(',');
+            out.put_fixed(percentile(millis, 0.99), 0, 3);
+            out.put('\n');
+        }
+        out.flush();
+    }
+
+    if (server > 0)
+    {
+        kill(server, SIGTERM);
+        waitpid(server, nullptr, 0);
+    }
+
+    if (!ok)
+    {
+        cerr << "# " << distribution_name(d) << " " << name << ": " << (ready ? "respuestas distintas o fallidas"
+                                                                           : "el servidor no arrancó: " + error)
+             << endl;
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Mide build_forest con un recurso de memoria y escribe una fila.
+ * @param out destino
+ * @param json true para JSON
+ * @param d distribución
+ * @param ps puntos con el EMST ya calculado
+ * @param pooled true para un pool, false para el heap
+ */
+static void measure_forest(output_writer &out, bool json, distribution d, const point_set &ps, bool pooled)
+{
+    counting_resource counter;
+    std::pmr::unsynchronized_pool_resource pool(&counter);
+    std::pmr::memory_resource *resource = pooled ? static_cast<std::pmr::memory_resource *>(&pool) : &counter;
+
+    double seconds;
+    double cost = 0.0;
+    {
+        // El bosque se destruye antes que el pool
+        forest st;
+
+        const auto start = chrono::steady_clock::now();
+        ps.build_forest(st, resource);
+        const auto stop = chrono::steady_clock::now();
+
+        seconds = chrono::duration<double>(stop - start).count();
+        for (const sub_tree &t : st)
+        {
+            cost += t.get_cost();
+        }
+    }
+
+    const char *name = pooled ? "pool" : "heap";
+
+    if (json)
+    {
+        out.put("{\"distribution\":\"");
+        out.put(distribution_name(d));
+        out.put("\",\"resource\":\"");
+        out.put(name);
+        out.put("\",\"n\":");
+        out.put(static_cast<unsigned long long>(ps.size()));
+        out.put(",\"seconds\":");
+        out.put_general(seconds);
+        out.put(",\"allocations\":");
+        out.put(static_cast<unsigned long long>(counter.allocations()));
+        out.put(",\"bytes\":");
+        out.put(static_cast<unsigned long long>(counter.bytes()));
+        out.put(",\"cost\":");
+        out.put_fixed(cost, 0, 6);
+        out.put("}\n");
+    }
+    else
+    {
+        out.put(distribution_name(d));
+        out.put(',');
+        out.put(name);
+        out.put(',');
+        out.put(static_cast<unsigned long long>(ps.size()));
+        out.put(',');
+        out.put_general(seconds);
+        out.put(',');
+        out.put(static_cast<unsigned long long>(counter.allocations()));
+        out.put(',');
+        out.put(static_cast<unsigned long long>(counter.bytes()));
+        out.put(',');
+        out.put_fixed(cost, 0, 6);
+        out.put('\n');
+    }
+    out.flush();
+}
+
+int main(int argc, char *argv[])
+{
+    vector<string> engine_names = {"kruskal", "filter", "prim", "delaunay", "boruvka"};
+    vector<string> distribution_names = {"uniform", "clustered", "grid", "collinear", "duplicate"};
+    int min_exp = 2;
+    int max_exp = 7;
+    int repetitions = 3;
+    int threads = 1;
+    bool json = false;
+    size_t quadratic_limit = 10000;
+    vector<string> approx_names;
+    int latency_requests = 0;
+    size_t latency_points = 1000;
+    string emst_program = "./emst";
+    bool forest_mode = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg(argv[i]);
+        if (arg == "-a" && i + 1 < argc)
+        {
+            engine_names = split(argv[++i]);
+        }
+        else if (arg == "-g" && i + 1 < argc)
+        {
+            distribution_names = split(argv[++i]);
+        }
+        else if (arg == "--min" && i + 1 < argc)
+        {
+            min_exp = atoi(argv[++i]);
+        }
+        else if (arg == "--max" && i + 1 < argc)
+        {
+            max_exp = atoi(argv[++i]);
+        }
+        else if (arg == "-r" && i + 1 < argc)
+        {
+            repetitions = atoi(argv[++i]);
+        }
+        else if (arg == "-j" && i + 1 < argc)
+        {
+            threads = atoi(argv[++i]);
+        }
+        else if (arg == "-f" && i + 1 < argc)
+        {
+            const string format(argv[++i]);
+            if (format != "csv" && format != "json")
+            {
+                cerr << "Formato desconocido: " << format << endl;
+                return 1;
+            }
+            json = (format == "json");
+        }
+        else if (arg == "--approx" && i + 1 < argc)
+        {
+            approx_names = split(argv[++i]);
+        }
+        else if (arg == "--quadratic-limit" && i + 1 < argc)
+        {
+            quadratic_limit = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--latency" && i + 1 < argc)
+        {
+            latency_requests = atoi(argv[++i]);
+        }
+        else if (arg == "--points" && i + 1 < argc)
+        {
+            latency_points = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--emst" && i + 1 < argc)
+        {
+            emst_program = argv[++i];
+        }
+        else if (arg == "--forest")
+        {
+            forest_mode = true;
+        }
+        else if (arg == "-h" || arg == "--help")
+        {
+            usage(cout, argv[0]);
+            return 0;
+        }
+        else
+        {
+            cerr << "Argumento desconocido: " << arg << endl;
+            usage(cerr, argv[0]);
+            return 1;
+        }
+    }
+
+    if (min_exp < 0 || max_exp > 9 || min_exp > max_exp || repetitions < 1 || threads < 1)
+    {
+        cerr << "Parámetros no válidos." << endl;
+        usage(cerr, argv[0]);
+        return 1;
+    }
+
+    // Validar los nombres antes de empezar a medir
+    vector<pair<string, engine>> engines;
+    for (const string &name : engine_names)
+    {
+        engine e;
+        if (!parse_engine(name, e))
+        {
+            cerr << "Motor desconocido: " << name << endl;
+            return 1;
+        }
+        engines.emplace_back(name, e);
+    }
+
+    // Motor aproximado: nombre de la fila y error relativo
+    vector<pair<string, double>> approximations;
+    for (const string &name : approx_names)
+    {
+        const double epsilon = atof(name.c_str());
+        if (!(epsilon > 0.0))
+        {
+            cerr << "Error relativo no válido: " << name << endl;
+            return 1;
+        }
+        approximations.emplace_back("approx-" + name, epsilon);
+    }
+
+    vector<distribution> distributions;
+    for (const string &name : distribution_names)
+    {
+        distribution d;
+        if (!parse_distribution(name, d))
+        {
+            cerr << "Distribución desconocida: " << name << endl;
+            return 1;
+        }
+        distributions.push_back(d);
+    }
+
+    output_writer out(1);
+
+    // Latencia de peticiones pequeñas: no se mide EMST en este proceso
+    if (latency_requests > 0)
+    {
+        if (!json)
+        {
+            out.put("distribution,engine,mode,n,requests,p50_ms,p99_ms\n");
+        }
+
+        bool ok = true;
+        for (distribution d : distributions)
+        {
+            for (const pair<string, engine> &en : engines)
+            {
+                ok = measure_latency(out, json, emst_program, d, en.first, latency_points, latency_requests,
+                                     threads) && ok;
+            }
+        }
+
+        return out.flush() && ok ? 0 : 1;
+    }
+
+    CyA::point_vector points;
+
+    // Bosque de sub_trees: reservas con el heap frente a un pool
+    if (forest_mode)
+    {
+        if (!json)
+        {
+            out.put("distribution,resource,n,seconds,allocations,bytes,cost\n");
+        }
+
+        for (distribution d : distributions)
+        {
+            size_t n = 1;
+            for (int k = 0; k < min_exp; ++k)
+            {
+                n *= 10;
+            }
+
+            for (int exp = min_exp; exp <= max_exp; ++exp, n *= 10)
+            {
+                generate_points(d, n, 1000003u * n + static_cast<unsigned>(d), points);
+
+                point_set ps(points);
+                ps.EMST(engine::delaunay);
+
+                measure_forest(out, json, d, ps, false);
+                measure_forest(out, json, d, ps, true);
+            }
+        }
+
+        return out.flush() ? 0 : 1;
+    }
+
+    if (!json)
+    {
+        out.put("distribution,engine,n,rep,threads,seconds,cost,dedup_seconds,generate_seconds,sort_seconds,"
+                "mst_seconds,edges_generated,finds,unions\n");
+    }
+
+    for (distribution d : distributions)
+    {
+        size_t n = 1;
+        for (int k = 0; k < min_exp; ++k)
+        {
+            n *= 10;
+        }
+
+        for (int exp = min_exp; exp <= max_exp; ++exp, n *= 10)
+        {
+            // La misma nube para todos los motores y repeticiones
+            generate_points(d, n, 1000003u * n + static_cast<unsigned>(d), points);
+
+            // Mide repetitions veces solve y escribe una fila por repetición
+            auto measure = [&](const string &name, auto solve) {
+                for (int rep = 0; rep < repetitions; ++rep)
+                {
+                    point_set ps(points);
+                    ps.set_threads(threads);
+
+                    const auto start = chrono::steady_clock::now();
+                    solve(ps);
+                    const auto stop = chrono::steady_clock::now();
+
+                    const double seconds = chrono::duration<double>(stop - start).count();
+                    write_row(out, json, distribution_name(d), name, n, rep, threads, seconds, ps.get_cost(),
+                              ps.get_stats());
+
+                    // Cada fila se ve en cuanto termina la medida
+                    out.flush();
+                }
+            };
+
+            for (const pair<string, engine> &en : engines)
+            {
+                if (is_quadratic(en.second) && n > quadratic_limit)
+                {
+                    cerr << "# " << distribution_name(d) << " " << en.first << " n=" << n
+                         << ": omitido (supera --quadratic-limit)" << endl;
+                    continue;
+                }
+
+                measure(en.first, [&](point_set &ps) { ps.EMST(en.second); });
+            }
+
+            for (const pair<string, double> &ap : approximations)
+            {
+                // La WSPD con separación s tiene del orden de s² n pares (como mucho n²/2)
+                const double s = 4.0 * (2.0 + ap.second) / ap.second;
+                const double pairs = min(s * s * n, 0.5 * n * n);
+                if (pairs > APPROX_EDGE_LIMIT)
+                {
+                    cerr << "# " << distribution_name(d) << " " << ap.first << " n=" << n
+                         << ": omitido (~" << static_cast<unsigned long long>(pairs) << " aristas)" << endl;
+                    continue;
+                }
+
+                measure(ap.first, [&](point_set &ps) { ps.EMST_approx(ap.second); });
+            }
+        }
+    }
+
+    return out.flush() ? 0 : 1;
+}
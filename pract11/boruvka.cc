@@ -0,0 +1,240 @@
+/**
+ * @file boruvka.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación del EMST por Borůvka dual-tree.
+ */
+
+#include "boruvka.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace EMST
+{
+    /**
+     * @brief Constructor: construye el kd-tree y una componente por punto.
+     * @param points vector de puntos
+     */
+    boruvka::boruvka(const CyA::point_vector &points) : points_(points),
+                                                        tree_(points),
+                                                        ds_(static_cast<int>(points.size())),
+                                                        component_(points.size()),
+                                                        node_component_(tree_.get_nodes().size()),
+                                                        node_bound_(tree_.get_nodes().size()),
+                                                        best_dist_(points.size()),
+                                                        best_from_(points.size()),
+                                                        best_to_(points.size())
+    {
+    }
+
+    /**
+     * @brief Destructor vacío.
+     */
+    boruvka::~boruvka(void)
+    {
+    }
+
+    /**
+     * @brief Rondas de Borůvka hasta que queda una sola componente.
+     * @param tree vector a rellenar con las aristas (i, j) del árbol
+     */
+    void boruvka::run(CyA::index_tree &tree)
+    {
+        const int n = static_cast<int>(points_.size());
+
+        tree.clear();
+        tree.reserve(n > 0 ? n - 1 : 0);
+
+        while (ds_.components() > 1)
+        {
+            // Componente de cada punto y de cada nodo para esta ronda
+            for (int i = 0; i < n; ++i)
+            {
+                component_[i] = ds_.find(i);
+                best_dist_[i] = std::numeric_limits<double>::infinity();
+                best_from_[i] = -1;
+                best_to_[i] = -1;
+            }
+
+            label_nodes();
+            std::fill(node_bound_.begin(), node_bound_.end(), std::numeric_limits<double>::infinity());
+
+            // Arista más corta de cada componente hacia cualquier otra
+            find_component_neighbors(0, 0);
+
+            // Añadir las aristas encontradas (el desempate por índices evita ciclos)
+            for (int c = 0; c < n; ++c)
+            {
+                if (component_[c] == c && best_from_[c] != -1)
+                {
+                    if (ds_.unite(best_from_[c], best_to_[c]))
+                    {
+                        tree.emplace_back(std::min(best_from_[c], best_to_[c]),
+                                          std::max(best_from_[c], best_to_[c]));
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Propaga de las hojas a la raíz la componente común de cada nodo.
+     */
+    void boruvka::label_nodes(void)
+    {
+        const std::vector<kd_node> &nodes = tree_.get_nodes();
+        const std::vector<int> &index = tree_.get_index();
+
+        // Los hijos se guardan después del padre: recorrer al revés es un postorden
+        for (int k = static_cast<int>(nodes.size()) - 1; k >= 0; --k)
+        {
+            const kd_node &node = nodes[k];
+
+            if (node.is_leaf())
+            {
+                int c = component_[index[node.begin]];
+                for (int p = node.begin + 1; p < node.end && c != -1; ++p)
+                {
+                    if (component_[index[p]] != c)
+                    {
+                        c = -1;
+                    }
+                }
+
+                node_component_[k] = c;
+            }
+            else
+            {
+                const int cl = node_component_[node.left];
+                node_component_[k] = (cl == node_component_[node.right]) ? cl : -1;
+            }
+        }
+    }
+
+    /**
+     * @brief Indica si la arista (d, i, j) mejora la mejor arista de la componente c.
+     * @param c componente
+     * @param d distancia al cuadrado
+     * @param i extremo dentro de c
+     * @param j extremo fuera de c
+     * @return true si es estrictamente mejor en el orden de arc_order
+     */
+    bool boruvka::improves(int c, double d, int i, int j) const
+    {
+        if (d != best_dist_[c])
+        {
+            return d < best_dist_[c];
+        }
+
+        if (best_from_[c] == -1)
+        {
+            return true;
+        }
+
+        return CyA::arc_order(points_).before(i, j, best_from_[c], best_to_[c]);
+    }
+
+    /**
+     * @brief Recorrido dual: poda pares de nodos de la misma componente o demasiado lejanos.
+     * @param q nodo de consulta
+     * @param r nodo de referencia
+     */
+    void boruvka::find_component_neighbors(int q, int r)
+    {
+        const std::vector<kd_node> &nodes = tree_.get_nodes();
+        const std::vector<int> &index = tree_.get_index();
+
+        // Todos los puntos de ambos nodos en la misma componente
+        if (node_component_[q] != -1 && node_component_[q] == node_component_[r])
+        {
+            return;
+        }
+
+        // Ningún par de puntos puede mejorar la cota del nodo de consulta
+        if (tree_.min_distance(q, r) > node_bound_[q])
+        {
+            return;
+        }
+
+        const kd_node &nq = nodes[q];
+        const kd_node &nr = nodes[r];
+
+        if (nq.is_leaf() && nr.is_leaf())
+        {
+            double bound = 0.0;
+
+            for (int a = nq.begin; a < nq.end; ++a)
+            {
+                const int i = index[a];
+                const int ci = component_[i];
+                const CyA::point &pi = points_[i];
+
+                for (int b = nr.begin; b < nr.end; ++b)
+                {
+                    const int j = index[b];
+
+                    if (component_[j] == ci)
+                    {
+                        continue;
+                    }
+
+                    const double dx = pi.first - points_[j].first;
+                    const double dy = pi.second - points_[j].second;
+                    const double d = dx * dx + dy * dy;
+
+                    if (improves(ci, d, i, j))
+                    {
+                        best_dist_[ci] = d;
+                        best_from_[ci] = i;
+                        best_to_[ci] = j;
+                    }
+                }
+
+                bound = std::max(bound, best_dist_[ci]);
+            }
+
+            node_bound_[q] = bound;
+            return;
+        }
+
+        if (nq.is_leaf())
+        {
+            // Visitar primero el hijo de referencia más cercano
+            int first = nr.left;
+            int second = nr.right;
+            if (tree_.min_distance(q, second) < tree_.min_distance(q, first))
+            {
+                std::swap(first, second);
+            }
+
+            find_component_neighbors(q, first);
+            find_component_neighbors(q, second);
+            return;
+        }
+
+        const int children[2] = {nq.left, nq.right};
+
+        for (int qc : children)
+        {
+            if (nr.is_leaf())
+            {
+                find_component_neighbors(qc, r);
+            }
+            else
+            {
+                int first = nr.left;
+                int second = nr.right;
+                if (tree_.min_distance(qc, second) < tree_.min_distance(qc, first))
+                {
+                    std::swap(first, second);
+                }
+
+                find_component_neighbors(qc, first);
+                find_component_neighbors(qc, second);
+            }
+        }
+
+        node_bound_[q] = std::max(node_bound_[nq.left], node_bound_[nq.right]);
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file boruvka.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Declaración de la clase boruvka: EMST por Borůvka dual sobre un kd-tree.
+ *
+ * En cada ronda se busca, para cada componente, su arista más corta hacia
+ * otra componente recorriendo a la vez dos nodos del kd-tree (consulta y
+ * referencia) y podando los pares de nodos que no pueden mejorar. Nunca se
+ * construye la lista de aristas: la memoria es O(n).
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "point_types.h"
+#include "kd_tree.h"
+#include "disjoint_set.h"
+
+namespace EMST
+{
+    /**
+     * @class boruvka
+     * @brief Motor EMST de Borůvka dual-tree (O(n log n) en la práctica).
+     */
+    class boruvka
+    {
+    private:
+        const CyA::point_vector &points_;
+        kd_tree tree_;
+        disjoint_set ds_;
+
+        std::vector<int> component_;      // componente de cada punto en la ronda actual
+        std::vector<int> node_component_; // componente común de un nodo (-1 si es mixto)
+        std::vector<double> node_bound_;  // cota de la peor mejor arista de los puntos del nodo
+
+        std::vector<double> best_dist_;   // mejor distancia (al cuadrado) de cada componente
+        std::vector<int> best_from_;
+        std::vector<int> best_to_;
+
+    public:
+        /**
+         * @brief Prepara el motor para el vector de puntos dado (se guarda una referencia).
+         * @param points vector de puntos
+         */
+        explicit boruvka(const CyA::point_vector &points);
+
+        /**
+         * @brief Destructor.
+         */
+        ~boruvka(void);
+
+        /**
+         * @brief Calcula el EMST.
+         * @param tree vector a rellenar con las n-1 aristas (i, j) del árbol
+         */
+        void run(CyA::index_tree &tree);
+
+        /**
+         * @brief Componentes tras run() (para los contadores de --stats).
+         * @return referencia constante al disjoint_set
+         */
+        inline const disjoint_set& get_components(void) const { return ds_; }
+
+    private:
+        /**
+         * @brief Calcula la componente común de cada nodo para la ronda actual.
+         */
+        void label_nodes(void);
+
+        /**
+         * @brief Recorre el par de nodos (consulta q, referencia r) actualizando best_*.
+         * @param q nodo de consulta
+         * @param r nodo de referencia
+         */
+        void find_component_neighbors(int q, int r);
+
+        /**
+         * @brief Compara la arista (d, i, j) con la mejor de la componente c.
+         * @return true si la nueva arista es estrictamente mejor (desempate por índices)
+         */
+        bool improves(int c, double d, int i, int j) const;
+    };
+}
@@ -0,0 +1,679 @@
+/**
+ * @file delaunay.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de la triangulación de Delaunay (barrido radial con volteos).
+ */
+
+#include "delaunay.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace EMST
+{
+    namespace
+    {
+        /**
+         * @brief Indica si (p, q, r) giran en sentido antihorario.
+         */
+        bool orient(double px, double py, double qx, double qy, double rx, double ry)
+        {
+            return (qy - py) * (rx - qx) - (qx - px) * (ry - qy) < 0.0;
+        }
+
+        /**
+         * @brief Indica si p cae dentro de la circunferencia circunscrita a (a, b, c).
+         */
+        bool in_circle(double ax, double ay, double bx, double by,
+                       double cx, double cy, double px, double py)
+        {
+            const double dx = ax - px;
+            const double dy = ay - py;
+            const double ex = bx - px;
+            const double ey = by - py;
+            const double fx = cx - px;
+            const double fy = cy - py;
+
+            const double ap = dx * dx + dy * dy;
+            const double bp = ex * ex + ey * ey;
+            const double cp = fx * fx + fy * fy;
+
+            return dx * (ey * cp - bp * fy) - dy * (ex * cp - bp * fx) + ap * (ex * fy - ey * fx) < 0.0;
+        }
+
+        /**
+         * @brief Cuadrado del radio de la circunferencia circunscrita a (a, b, c).
+         */
+        double circumradius(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            const double dx = bx - ax;
+            const double dy = by - ay;
+            const double ex = cx - ax;
+            const double ey = cy - ay;
+
+            const double bl = dx * dx + dy * dy;
+            const double cl = ex * ex + ey * ey;
+            const double d = 0.5 / (dx * ey - dy * ex);
+
+            const double x = (ey * bl - dy * cl) * d;
+            const double y = (dx * cl - ex * bl) * d;
+
+            const double r = x * x + y * y;
+
+            // Puntos colineales: el radio es infinito (o NaN)
+            return std::isfinite(r) ? r : std::numeric_limits<double>::infinity();
+        }
+
+        /**
+         * @brief Centro de la circunferencia circunscrita a (a, b, c).
+         */
+        CyA::point circumcenter(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            const double dx = bx - ax;
+            const double dy = by - ay;
+            const double ex = cx - ax;
+            const double ey = cy - ay;
+
+            const double bl = dx * dx + dy * dy;
+            const double cl = ex * ex + ey * ey;
+            const double d = 0.5 / (dx * ey - dy * ex);
+
+            return std::make_pair(ax + (ey * bl - dy * cl) * d, ay + (dx * cl - ex * bl) * d);
+        }
+
+        /**
+         * @brief Pseudo-ángulo en [0, 1) monótono con el ángulo real de (dx, dy).
+         */
+        double pseudo_angle(double dx, double dy)
+        {
+            // Punto sobre el propio centro: cualquier ángulo es válido
+            if (dx == 0.0 && dy == 0.0)
+            {
+                return 0.0;
+            }
+
+            const double p = dx / (std::fabs(dx) + std::fabs(dy));
+
+            return (dy > 0.0 ? 3.0 - p : 1.0 + p) / 4.0;
+        }
+
+        /**
+         * @brief Cuadrado de la distancia entre (ax, ay) y (bx, by).
+         */
+        double squared_distance(double ax, double ay, double bx, double by)
+        {
+            const double dx = ax - bx;
+            const double dy = ay - by;
+
+            return dx * dx + dy * dy;
+        }
+    }
+
+    /**
+     * @brief Constructor: elimina duplicados y triangula.
+     * @param points vector de puntos
+     */
+    delaunay::delaunay(const CyA::point_vector &points) : points_(points),
+                                                          unique_(),
+                                                          duplicate_of_(),
+                                                          triangles_(),
+                                                          halfedges_(),
+                                                          skipped_(),
+                                                          hull_prev_(),
+                                                          hull_next_(),
+                                                          hull_tri_(),
+                                                          hull_hash_(),
+                                                          edge_stack_(),
+                                                          hull_start_(-1),
+                                                          hash_size_(0),
+                                                          cx_(0.0),
+                                                          cy_(0.0)
+    {
+        remove_duplicates();
+
+        if (!triangulate())
+        {
+            triangles_.clear();
+            halfedges_.clear();
+        }
+    }
+
+    /**
+     * @brief Destructor vacío.
+     */
+    delaunay::~delaunay(void)
+    {
+    }
+
+    /**
+     * @brief Ordena los índices por coordenadas y agrupa los puntos idénticos.
+     */
+    void delaunay::remove_duplicates(void)
+    {
+        const int n = static_cast<int>(points_.size());
+
+        std::vector<int> order(n);
+        for (int i = 0; i < n; ++i)
+        {
+            order[i] = i;
+        }
+
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return points_[a] < points_[b] || (points_[a] == points_[b] && a < b);
+        });
+
+        duplicate_of_.assign(n, -1);
+        unique_.clear();
+
+        for (int k = 0; k < n; ++k)
+        {
+            const int i = order[k];
+
+            // El primer punto de cada grupo de iguales es su representante
+            if (k > 0 && points_[i] == points_[order[k - 1]])
+            {
+                duplicate_of_[i] = duplicate_of_[order[k - 1]];
+            }
+            else
+            {
+                duplicate_of_[i] = i;
+                unique_.push_back(i);
+            }
+        }
+    }
+
+    /**
+     * @brief Triangula los puntos únicos por barrido radial desde un triángulo semilla.
+     * @return false si no existe ningún triángulo (puntos colineales o menos de 3)
+     */
+    bool delaunay::triangulate(void)
+    {
+        const int n = static_cast<int>(points_.size());
+        const int m = static_cast<int>(unique_.size());
+
+        if (m < 3)
+        {
+            return false;
+        }
+
+        // Centro de la caja envolvente
+        double min_x = std::numeric_limits<double>::infinity();
+        double min_y = std::numeric_limits<double>::infinity();
+        double max_x = -std::numeric_limits<double>::infinity();
+        double max_y = -std::numeric_limits<double>::infinity();
+
+        for (int i : unique_)
+        {
+            min_x = std::min(min_x, points_[i].first);
+            min_y = std::min(min_y, points_[i].second);
+            max_x = std::max(max_x, points_[i].first);
+            max_y = std::max(max_y, points_[i].second);
+        }
+
+        const double bx = (min_x + max_x) / 2.0;
+        const double by = (min_y + max_y) / 2.0;
+
+        // Semilla: punto más cercano al centro, su vecino más cercano y el
+        // tercero que forme el menor círculo circunscrito
+        int i0 = -1;
+        int i1 = -1;
+        int i2 = -1;
+
+        double min_dist = std::numeric_limits<double>::infinity();
+        for (int i : unique_)
+        {
+            const double d = squared_distance(bx, by, points_[i].first, points_[i].second);
+            if (d < min_dist)
+            {
+                i0 = i;
+                min_dist = d;
+            }
+        }
+
+        const double i0x = points_[i0].first;
+        const double i0y = points_[i0].second;
+
+        // Puntos alineados salvo errores de redondeo (p. ej. y = 2x + 1): la
+        // semilla sería casi degenerada y el barrido no es fiable
+        if (nearly_collinear(i0))
+        {
+            return false;
+        }
+
+        min_dist = std::numeric_limits<double>::infinity();
+        for (int i : unique_)
+        {
+            if (i == i0)
+            {
+                continue;
+            }
+
+            const double d = squared_distance(i0x, i0y, points_[i].first, points_[i].second);
+            if (d < min_dist && d > 0.0)
+            {
+                i1 = i;
+                min_dist = d;
+            }
+        }
+
+        double i1x = points_[i1].first;
+        double i1y = points_[i1].second;
+
+        double min_radius = std::numeric_limits<double>::infinity();
+        for (int i : unique_)
+        {
+            if (i == i0 || i == i1)
+            {
+                continue;
+            }
+
+            const double r = circumradius(i0x, i0y, i1x, i1y, points_[i].first, points_[i].second);
+            if (r < min_radius)
+            {
+                i2 = i;
+                min_radius = r;
+            }
+        }
+
+        // Todos los puntos son colineales
+        if (i2 == -1)
+        {
+            return false;
+        }
+
+        double i2x = points_[i2].first;
+        double i2y = points_[i2].second;
+
+        // La semilla se orienta en sentido horario
+        if (orient(i0x, i0y, i1x, i1y, i2x, i2y))
+        {
+            std::swap(i1, i2);
+            std::swap(i1x, i2x);
+            std::swap(i1y, i2y);
+        }
+
+        const CyA::point center = circumcenter(i0x, i0y, i1x, i1y, i2x, i2y);
+        cx_ = center.first;
+        cy_ = center.second;
+
+        // Orden de inserción: distancia creciente al circuncentro de la semilla
+        std::vector<double> dists(n, 0.0);
+        for (int i : unique_)
+        {
+            dists[i] = squared_distance(points_[i].first, points_[i].second, cx_, cy_);
+        }
+
+        std::vector<int> ids(unique_);
+        std::sort(ids.begin(), ids.end(), [&](int a, int b) {
+            return dists[a] < dists[b] || (dists[a] == dists[b] && a < b);
+        });
+
+        // Envolvente convexa como lista doblemente enlazada con hash angular
+        hash_size_ = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(m))));
+        hull_prev_.assign(n, -1);
+        hull_next_.assign(n, -1);
+        hull_tri_.assign(n, -1);
+        hull_hash_.assign(hash_size_, -1);
+
+        hull_start_ = i0;
+
+        hull_next_[i0] = hull_prev_[i2] = i1;
+        hull_next_[i1] = hull_prev_[i0] = i2;
+        hull_next_[i2] = hull_prev_[i1] = i0;
+
+        hull_tri_[i0] = 0;
+        hull_tri_[i1] = 1;
+        hull_tri_[i2] = 2;
+
+        hull_hash_[hash_key(i0x, i0y)] = i0;
+        hull_hash_[hash_key(i1x, i1y)] = i1;
+        hull_hash_[hash_key(i2x, i2y)] = i2;
+
+        // Una triangulación de m puntos tiene como mucho 2m - 5 triángulos
+        const size_t max_triangles = static_cast<size_t>(std::max(2 * m - 5, 1));
+        triangles_.clear();
+        halfedges_.clear();
+        triangles_.reserve(max_triangles * 3);
+        halfedges_.reserve(max_triangles * 3);
+
+        add_triangle(i0, i1, i2, -1, -1, -1);
+
+        for (int i : ids)
+        {
+            if (i == i0 || i == i1 || i == i2)
+            {
+                continue;
+            }
+
+            const double x = points_[i].first;
+            const double y = points_[i].second;
+
+            // Buscar una arista visible de la envolvente a partir del hash angular
+            int start = 0;
+            const int key = hash_key(x, y);
+            for (int j = 0; j < hash_size_; ++j)
+            {
+                start = hull_hash_[(key + j) % hash_size_];
+                if (start != -1 && start != hull_next_[start])
+                {
+                    break;
+                }
+            }
+
+            start = hull_prev_[start];
+            int e = start;
+            int q = hull_next_[e];
+
+            while (!orient(x, y, points_[e].first, points_[e].second, points_[q].first, points_[q].second))
+            {
+                e = q;
+                if (e == start)
+                {
+                    e = -1;
+                    break;
+                }
+                q = hull_next_[e];
+            }
+
+            // Punto casi coincidente con la envolvente: se conecta aparte
+            if (e == -1)
+            {
+                skipped_.push_back(i);
+                continue;
+            }
+
+            // Primer triángulo desde el punto y legalización
+            int t = add_triangle(e, i, hull_next_[e], -1, -1, hull_tri_[e]);
+
+            hull_tri_[i] = legalize(t + 2);
+            hull_tri_[e] = t;
+
+            // Avanzar por la envolvente añadiendo triángulos mientras sea visible
+            int next = hull_next_[e];
+            q = hull_next_[next];
+            while (orient(x, y, points_[next].first, points_[next].second, points_[q].first, points_[q].second))
+            {
+                t = add_triangle(next, i, q, hull_tri_[i], -1, hull_tri_[next]);
+                hull_tri_[i] = legalize(t + 2);
+                hull_next_[next] = next; // marcado como eliminado
+                next = q;
+                q = hull_next_[next];
+            }
+
+            // Retroceder por el otro lado
+            if (e == start)
+            {
+                q = hull_prev_[e];
+                while (orient(x, y, points_[q].first, points_[q].second, points_[e].first, points_[e].second))
+                {
+                    t = add_triangle(q, i, e, -1, hull_tri_[e], hull_tri_[q]);
+                    legalize(t + 2);
+                    hull_tri_[q] = t;
+                    hull_next_[e] = e; // marcado como eliminado
+                    e = q;
+                    q = hull_prev_[e];
+                }
+            }
+
+            // Actualizar la envolvente
+            hull_start_ = hull_prev_[i] = e;
+            hull_next_[e] = hull_prev_[next] = i;
+            hull_next_[i] = next;
+
+            hull_hash_[hash_key(x, y)] = i;
+            hull_hash_[hash_key(points_[e].first, points_[e].second)] = e;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Comprueba si todos los puntos únicos están a una distancia despreciable
+     *        (relativa a su extensión) de una recta que pasa por a.
+     *
+     * En ese caso deja unique_ ordenado a lo largo de la recta para get_edges.
+     * @param a punto de referencia
+     * @return true si los puntos se tratan como colineales
+     */
+    bool delaunay::nearly_collinear(int a)
+    {
+        const double ax = points_[a].first;
+        const double ay = points_[a].second;
+
+        // Dirección de la recta: hacia el punto más alejado de a
+        int far = a;
+        double max_dist = 0.0;
+        for (int i : unique_)
+        {
+            const double d = squared_distance(ax, ay, points_[i].first, points_[i].second);
+            if (d > max_dist)
+            {
+                far = i;
+                max_dist = d;
+            }
+        }
+
+        const double ux = points_[far].first - ax;
+        const double uy = points_[far].second - ay;
+
+        // |u x (p - a)| = |u| * distancia de p a la recta; tolerancia 1e-10 * |u|
+        const double tolerance = 1e-10 * max_dist;
+        for (int i : unique_)
+        {
+            const double cross = ux * (points_[i].second - ay) - uy * (points_[i].first - ax);
+            if (std::fabs(cross) > tolerance)
+            {
+                return false;
+            }
+        }
+
+        // a puede estar en medio: ordenar por la proyección sobre u
+        std::sort(unique_.begin(), unique_.end(), [&](int i, int j) {
+            const double pi = ux * (points_[i].first - ax) + uy * (points_[i].second - ay);
+            const double pj = ux * (points_[j].first - ax) + uy * (points_[j].second - ay);
+            return pi < pj || (pi == pj && i < j);
+        });
+
+        return true;
+    }
+
+    /**
+     * @brief Añade el triángulo (i0, i1, i2) enlazando sus aristas con a, b y c.
+     * @return índice de la primera media arista
+     */
+    int delaunay::add_triangle(int i0, int i1, int i2, int a, int b, int c)
+    {
+        const int t = static_cast<int>(triangles_.size());
+
+        triangles_.push_back(i0);
+        triangles_.push_back(i1);
+        triangles_.push_back(i2);
+
+        halfedges_.push_back(-1);
+        halfedges_.push_back(-1);
+        halfedges_.push_back(-1);
+
+        link(t, a);
+        link(t + 1, b);
+        link(t + 2, c);
+
+        return t;
+    }
+
+    /**
+     * @brief Enlaza las medias aristas a y b (b puede ser -1).
+     */
+    void delaunay::link(int a, int b)
+    {
+        halfedges_[a] = b;
+
+        if (b != -1)
+        {
+            halfedges_[b] = a;
+        }
+    }
+
+    /**
+     * @brief Legaliza iterativamente las aristas afectadas por la última inserción.
+     * @param a media arista inicial
+     * @return media arista que queda en la envolvente
+     */
+    int delaunay::legalize(int a)
+    {
+        edge_stack_.clear();
+        int ar = 0;
+
+        while (true)
+        {
+            const int b = halfedges_[a];
+
+            const int a0 = a - a % 3;
+            ar = a0 + (a + 2) % 3;
+
+            // Arista de la envolvente: no hay nada que voltear
+            if (b == -1)
+            {
+                if (edge_stack_.empty())
+                {
+                    break;
+                }
+
+                a = edge_stack_.back();
+                edge_stack_.pop_back();
+                continue;
+            }
+
+            const int b0 = b - b % 3;
+            const int al = a0 + (a + 1) % 3;
+            const int bl = b0 + (b + 2) % 3;
+
+            const int p0 = triangles_[ar];
+            const int pr = triangles_[a];
+            const int pl = triangles_[al];
+            const int p1 = triangles_[bl];
+
+            const bool illegal = in_circle(points_[p0].first, points_[p0].second,
+                                           points_[pr].first, points_[pr].second,
+                                           points_[pl].first, points_[pl].second,
+                                           points_[p1].first, points_[p1].second);
+
+            if (illegal)
+            {
+                triangles_[a] = p1;
+                triangles_[b] = p0;
+
+                const int hbl = halfedges_[bl];
+
+                // Arista volteada al otro lado de la envolvente: corregir la referencia
+                if (hbl == -1)
+                {
+                    int e = hull_start_;
+                    do
+                    {
+                        if (hull_tri_[e] == bl)
+                        {
+                            hull_tri_[e] = a;
+                            break;
+                        }
+                        e = hull_prev_[e];
+                    } while (e != hull_start_);
+                }
+
+                link(a, hbl);
+                link(b, halfedges_[ar]);
+                link(ar, bl);
+
+                edge_stack_.push_back(b0 + (b + 1) % 3);
+            }
+            else
+            {
+                if (edge_stack_.empty())
+                {
+                    break;
+                }
+
+                a = edge_stack_.back();
+                edge_stack_.pop_back();
+            }
+        }
+
+        return ar;
+    }
+
+    /**
+     * @brief Clave del hash angular respecto al circuncentro de la semilla.
+     */
+    int delaunay::hash_key(double x, double y) const
+    {
+        const int key = static_cast<int>(std::floor(pseudo_angle(x - cx_, y - cy_) * hash_size_));
+
+        return key % hash_size_;
+    }
+
+    /**
+     * @brief Peso de la arista (i, j): distancia al cuadrado, que ordena igual que la euclídea.
+     */
+    double delaunay::weight(int i, int j) const
+    {
+        return squared_distance(points_[i].first, points_[i].second,
+                                points_[j].first, points_[j].second);
+    }
+
+    /**
+     * @brief Genera las aristas candidatas (Delaunay + duplicados + casos degenerados).
+     * @param av vector a rellenar con aristas (distancia al cuadrado, i, j)
+     */
+    void delaunay::get_edges(CyA::index_arc_vector &av) const
+    {
+        av.clear();
+        av.reserve(halfedges_.size() / 2 + points_.size());
+
+        // Cada punto duplicado se une a su representante con peso 0
+        for (int i = 0; i < static_cast<int>(duplicate_of_.size()); ++i)
+        {
+            if (duplicate_of_[i] != i)
+            {
+                av.emplace_back(0.0, duplicate_of_[i], i);
+            }
+        }
+
+        if (triangles_.empty())
+        {
+            // Sin triángulos todos los puntos únicos están (casi) alineados y
+            // unique_ ya los recorre en orden sobre la recta
+            for (size_t k = 1; k < unique_.size(); ++k)
+            {
+                av.emplace_back(weight(unique_[k - 1], unique_[k]), unique_[k - 1], unique_[k]);
+            }
+
+            return;
+        }
+
+        // Cada arista de la triangulación una sola vez
+        for (int e = 0; e < static_cast<int>(triangles_.size()); ++e)
+        {
+            if (halfedges_[e] == -1 || e > halfedges_[e])
+            {
+                const int i = triangles_[e];
+                const int j = triangles_[e % 3 == 2 ? e - 2 : e + 1];
+
+                av.emplace_back(weight(i, j), std::min(i, j), std::max(i, j));
+            }
+        }
+
+        // Los puntos que no se pudieron insertar se conectan con todos los demás:
+        // el EMST restringido al resto sigue estando en la triangulación calculada
+        for (int s : skipped_)
+        {
+            for (int i : unique_)
+            {
+                if (i != s)
+                {
+                    av.emplace_back(weight(s, i), std::min(s, i), std::max(s, i));
+                }
+            }
+        }
+    }
+}
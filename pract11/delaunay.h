@@ -0,0 +1,123 @@
+/**
+ * @file delaunay.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Declaración de la clase delaunay que triangula un conjunto de puntos 2D.
+ *
+ * El EMST en el plano es un subgrafo de la triangulación de Delaunay, por lo que
+ * basta con pasar a Kruskal sus ~3n aristas en lugar de las n(n-1)/2 parejas.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "point_types.h"
+
+namespace EMST
+{
+    /**
+     * @class delaunay
+     * @brief Triangulación de Delaunay por barrido radial de la envolvente (O(n log n)).
+     *
+     * Los puntos se insertan ordenados por distancia a un triángulo semilla,
+     * añadiendo triángulos contra la envolvente convexa visible y legalizando
+     * con volteos de aristas. Los triángulos se guardan como medias aristas.
+     */
+    class delaunay
+    {
+    private:
+        const CyA::point_vector &points_;
+
+        std::vector<int> unique_;      // índices de los puntos sin duplicados
+        std::vector<int> duplicate_of_; // representante de cada punto (él mismo si es único)
+
+        std::vector<int> triangles_;   // vértices de cada triángulo (3 por triángulo)
+        std::vector<int> halfedges_;   // media arista opuesta (-1 en la envolvente)
+        std::vector<int> skipped_;     // puntos que no se pudieron insertar
+
+        std::vector<int> hull_prev_;
+        std::vector<int> hull_next_;
+        std::vector<int> hull_tri_;
+        std::vector<int> hull_hash_;
+        std::vector<int> edge_stack_;
+        int hull_start_;
+        int hash_size_;
+        double cx_;
+        double cy_;
+
+    public:
+        /**
+         * @brief Triangula el vector de puntos dado (se guarda una referencia).
+         * @param points vector de puntos
+         */
+        explicit delaunay(const CyA::point_vector &points);
+
+        /**
+         * @brief Destructor.
+         */
+        ~delaunay(void);
+
+        /**
+         * @brief Devuelve las aristas candidatas al EMST con su peso (distancia al cuadrado).
+         *
+         * Incluye las aristas de la triangulación, una arista de peso 0 por cada
+         * punto duplicado y, si todos los puntos son colineales, la cadena que los une.
+         * @param av vector a rellenar con aristas (distancia al cuadrado, i, j)
+         */
+        void get_edges(CyA::index_arc_vector &av) const;
+
+        /**
+         * @brief Devuelve los vértices de los triángulos (3 índices por triángulo).
+         * @return referencia constante al vector de triángulos
+         */
+        inline const std::vector<int>& get_triangles(void) const { return triangles_; }
+
+    private:
+        /**
+         * @brief Agrupa los puntos con coordenadas idénticas en un único representante.
+         */
+        void remove_duplicates(void);
+
+        /**
+         * @brief Construye la triangulación sobre los puntos únicos.
+         * @return false si todos los puntos son colineales (no hay triángulos)
+         */
+        bool triangulate(void);
+
+        /**
+         * @brief Detecta puntos alineados salvo redondeo y los ordena sobre la recta.
+         * @param a punto de referencia (el más cercano al centro)
+         * @return true si se tratan como colineales
+         */
+        bool nearly_collinear(int a);
+
+        /**
+         * @brief Añade un triángulo y enlaza sus medias aristas.
+         * @return índice de la primera media arista del triángulo
+         */
+        int add_triangle(int i0, int i1, int i2, int a, int b, int c);
+
+        /**
+         * @brief Enlaza dos medias aristas opuestas.
+         */
+        void link(int a, int b);
+
+        /**
+         * @brief Voltea aristas desde a hasta cumplir la condición de Delaunay.
+         * @param a media arista inicial
+         * @return media arista que queda en la envolvente
+         */
+        int legalize(int a);
+
+        /**
+         * @brief Clave del hash angular de la envolvente para el punto (x, y).
+         */
+        int hash_key(double x, double y) const;
+
+        /**
+         * @brief Distancia al cuadrado entre los puntos i y j.
+         */
+        double weight(int i, int j) const;
+    };
+}
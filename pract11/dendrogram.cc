@@ -0,0 +1,141 @@
+/**
+ * @file dendrogram.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación del dendrograma de enlace simple.
+ */
+
+#include "dendrogram.h"
+#include "disjoint_set.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace EMST
+{
+    /**
+     * @brief Ordena las aristas del árbol y registra las fusiones que producen.
+     * @param points puntos del conjunto
+     * @param tree aristas del EMST
+     */
+    dendrogram::dendrogram(const CyA::point_vector &points, const CyA::index_tree &tree) : n_(points.size()),
+                                                                                           merges_()
+    {
+        // Aristas por distancia creciente (desempate por índices, como Kruskal)
+        CyA::index_arc_vector edges;
+        edges.reserve(tree.size());
+        for (const CyA::index_arc &a : tree)
+        {
+            const double dx = points[a.first].first - points[a.second].first;
+            const double dy = points[a.first].second - points[a.second].second;
+            edges.emplace_back(dx * dx + dy * dy, a.first, a.second);
+        }
+
+        std::sort(edges.begin(), edges.end());
+
+        // cluster[r]: identificador de cluster del representante r del union-find
+        disjoint_set ds(static_cast<int>(n_));
+        std::vector<int> cluster(n_);
+        for (std::size_t i = 0; i < n_; ++i)
+        {
+            cluster[i] = static_cast<int>(i);
+        }
+
+        merges_.reserve(edges.size());
+
+        for (const CyA::weighted_index_arc &e : edges)
+        {
+            const int ri = ds.find(e.i);
+            const int rj = ds.find(e.j);
+
+            dendrogram_merge m;
+            m.a = std::min(cluster[ri], cluster[rj]);
+            m.b = std::max(cluster[ri], cluster[rj]);
+            m.height = std::sqrt(e.weight);
+            m.size = ds.component_size(ri) + ds.component_size(rj);
+            m.i = static_cast<int>(cluster[ri] < cluster[rj] ? e.i : e.j);
+            m.j = static_cast<int>(cluster[ri] < cluster[rj] ? e.j : e.i);
+
+            ds.unite(ri, rj);
+            cluster[ds.find(ri)] = static_cast<int>(n_ + merges_.size());
+
+            merges_.push_back(m);
+        }
+    }
+
+    /**
+     * @brief Destructor vacío.
+     */
+    dendrogram::~dendrogram(void)
+    {
+    }
+
+    /**
+     * @brief Clusters a distancia t: n menos las fusiones de altura <= t.
+     * @param t umbral
+     * @return número de clusters
+     */
+    std::size_t dendrogram::clusters_at(double t) const
+    {
+        const std::size_t m = std::upper_bound(merges_.begin(), merges_.end(), t,
+                                               [](double v, const dendrogram_merge &x) { return v < x.height; }) -
+                              merges_.begin();
+
+        return n_ - m;
+    }
+
+    /**
+     * @brief Etiquetas a distancia t.
+     * @param t umbral
+     * @param labels etiquetas (salida)
+     * @return número de clusters
+     */
+    std::size_t dendrogram::cut_threshold(double t, std::vector<int> &labels) const
+    {
+        return label(n_ - clusters_at(t), labels);
+    }
+
+    /**
+     * @brief Etiquetas con k clusters: se aplican las n-k primeras fusiones.
+     * @param k número de clusters
+     * @param labels etiquetas (salida)
+     * @return número de clusters
+     */
+    std::size_t dendrogram::cut_clusters(std::size_t k, std::vector<int> &labels) const
+    {
+        k = std::max<std::size_t>(1, std::min(k, n_));
+
+        return label(n_ > 0 ? n_ - k : 0, labels);
+    }
+
+    /**
+     * @brief Une los extremos de las m primeras fusiones y numera las componentes.
+     * @param m fusiones aplicadas
+     * @param labels etiquetas (salida)
+     * @return número de clusters
+     */
+    std::size_t dendrogram::label(std::size_t m, std::vector<int> &labels) const
+    {
+        disjoint_set ds(static_cast<int>(n_));
+        for (std::size_t k = 0; k < m && k < merges_.size(); ++k)
+        {
+            ds.unite(merges_[k].i, merges_[k].j);
+        }
+
+        // Etiquetas 0..k-1 por orden del primer punto de cada cluster
+        std::vector<int> id(n_, -1);
+        labels.assign(n_, 0);
+
+        int next = 0;
+        for (std::size_t p = 0; p < n_; ++p)
+        {
+            const int r = ds.find(static_cast<int>(p));
+            if (id[r] == -1)
+            {
+                id[r] = next++;
+            }
+            labels[p] = id[r];
+        }
+
+        return static_cast<std::size_t>(next);
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file dendrogram.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Dendrograma de enlace simple (single-linkage) construido a partir del EMST.
+ *
+ * Los clusters de enlace simple a distancia t son las componentes del EMST
+ * tras quitar las aristas de longitud mayor que t, así que basta con ordenar
+ * una vez las n-1 aristas del árbol: cortar por un umbral o en k clusters es
+ * repetir las primeras fusiones con un union-find (O(n α(n))).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "point_types.h"
+
+namespace EMST
+{
+    /**
+     * @brief Fusión del dendrograma (formato de enlace de SciPy).
+     *
+     * Los clusters 0..n-1 son los puntos; la fusión k crea el cluster n + k.
+     */
+    struct dendrogram_merge
+    {
+        int a;         ///< primer cluster fusionado
+        int b;         ///< segundo cluster fusionado
+        double height; ///< distancia de la fusión (longitud de la arista del EMST)
+        int size;      ///< puntos del cluster resultante
+        int i;         ///< extremo de la arista en el primer cluster
+        int j;         ///< extremo de la arista en el segundo cluster
+    };
+
+    /**
+     * @class dendrogram
+     * @brief Orden de fusión de las aristas del EMST y consultas de corte.
+     */
+    class dendrogram
+    {
+    private:
+        std::size_t n_;
+        std::vector<dendrogram_merge> merges_; // por altura creciente
+
+    public:
+        /**
+         * @brief Construye el dendrograma ordenando las aristas del árbol.
+         * @param points puntos del conjunto
+         * @param tree aristas del EMST (pares de índices)
+         */
+        dendrogram(const CyA::point_vector &points, const CyA::index_tree &tree);
+
+        /**
+         * @brief Destructor.
+         */
+        ~dendrogram(void);
+
+        /**
+         * @brief Devuelve las fusiones por altura creciente.
+         * @return referencia constante a las fusiones
+         */
+        inline const std::vector<dendrogram_merge>& get_merges(void) const { return merges_; }
+
+        /**
+         * @brief Número de clusters a distancia t (O(log n)).
+         * @param t umbral: se fusionan las aristas de longitud <= t
+         * @return número de clusters
+         */
+        std::size_t clusters_at(double t) const;
+
+        /**
+         * @brief Etiqueta de cluster de cada punto a distancia t.
+         * @param t umbral
+         * @param labels etiqueta 0..k-1 de cada punto, numeradas por orden de aparición
+         * @return número de clusters k
+         */
+        std::size_t cut_threshold(double t, std::vector<int> &labels) const;
+
+        /**
+         * @brief Etiqueta de cluster de cada punto al cortar en k clusters.
+         * @param k número de clusters (se ajusta a [1, n])
+         * @param labels etiqueta 0..k-1 de cada punto
+         * @return número de clusters obtenido
+         */
+        std::size_t cut_clusters(std::size_t k, std::vector<int> &labels) const;
+
+    private:
+        /**
+         * @brief Repite las primeras m fusiones y numera las componentes.
+         */
+        std::size_t label(std::size_t m, std::vector<int> &labels) const;
+    };
+}
@@ -0,0 +1,108 @@
+/**
+ * @file disjoint_set.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de disjoint_set (union-find).
+ */
+
+#include "disjoint_set.h"
+
+#include <utility>
+
+namespace EMST
+{
+    /**
+     * @brief Constructor: crea n componentes aisladas.
+     * @param n número de elementos
+     */
+    disjoint_set::disjoint_set(int n) : parent_(),
+                                        size_(),
+                                        components_(0),
+                                        finds_(0),
+                                        unions_(0)
+    {
+        reset(n);
+    }
+
+    /**
+     * @brief Destructor vacío.
+     */
+    disjoint_set::~disjoint_set(void)
+    {
+    }
+
+    /**
+     * @brief Reinicia la estructura: cada elemento es su propio representante.
+     * @param n número de elementos
+     */
+    void disjoint_set::reset(int n)
+    {
+        parent_.resize(n);
+        size_.assign(n, 1);
+        components_ = n;
+        finds_ = 0;
+        unions_ = 0;
+
+        for (int i = 0; i < n; ++i)
+        {
+            parent_[i] = i;
+        }
+    }
+
+    /**
+     * @brief Busca el representante de x comprimiendo el camino recorrido.
+     * @param x índice del elemento
+     * @return índice del representante
+     */
+    int disjoint_set::find(int x)
+    {
+        ++finds_;
+
+        // Subir hasta la raíz
+        int root = x;
+        while (parent_[root] != root)
+        {
+            root = parent_[root];
+        }
+
+        // Compresión de caminos: todos los nodos recorridos apuntan a la raíz
+        while (parent_[x] != root)
+        {
+            const int next = parent_[x];
+            parent_[x] = root;
+            x = next;
+        }
+
+        return root;
+    }
+
+    /**
+     * @brief Une las componentes de x e y usando unión por tamaño.
+     * @param x índice del primer elemento
+     * @param y índice del segundo elemento
+     * @return true si se ha realizado la unión
+     */
+    bool disjoint_set::unite(int x, int y)
+    {
+        int rx = find(x);
+        int ry = find(y);
+
+        // Ya estaban en la misma componente: la arista formaría un ciclo
+        if (rx == ry)
+        {
+            return false;
+        }
+
+        // La componente pequeña cuelga de la grande
+        if (size_[rx] < size_[ry])
+        {
+            std::swap(rx, ry);
+        }
+
+        parent_[ry] = rx;
+        size_[rx] += size_[ry];
+        --components_;
+        ++unions_;
+
+        return true;
+    }
+}
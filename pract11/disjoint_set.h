@@ -0,0 +1,99 @@
+/**
+ * @file disjoint_set.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Declaración de la clase disjoint_set (union-find) usada por Kruskal.
+ *
+ * Mantiene las componentes conexas del bosque indexadas por la posición
+ * de cada punto en el point_vector, con compresión de caminos y unión por tamaño.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace EMST
+{
+    /**
+     * @class disjoint_set
+     * @brief Estructura union-find sobre los índices 0..n-1.
+     *
+     * Cada operación find/unite tiene coste amortizado casi constante
+     * (inversa de la función de Ackermann).
+     */
+    class disjoint_set
+    {
+    private:
+        std::vector<int> parent_;
+        std::vector<int> size_;
+        int components_;
+        std::uint64_t finds_;  // llamadas a find (incluidas las de unite y same)
+        std::uint64_t unions_; // uniones realizadas
+
+    public:
+        /**
+         * @brief Construye n componentes aisladas (una por índice).
+         * @param n número de elementos
+         */
+        explicit disjoint_set(int n = 0);
+
+        /**
+         * @brief Destructor.
+         */
+        ~disjoint_set(void);
+
+        /**
+         * @brief Reinicia la estructura con n componentes aisladas.
+         * @param n número de elementos
+         */
+        void reset(int n);
+
+        /**
+         * @brief Devuelve el representante de la componente de x (comprime el camino).
+         * @param x índice del elemento
+         * @return índice del representante
+         */
+        int find(int x);
+
+        /**
+         * @brief Une las componentes de x e y (la menor cuelga de la mayor).
+         * @param x índice del primer elemento
+         * @param y índice del segundo elemento
+         * @return true si estaban en componentes distintas, false en caso contrario
+         */
+        bool unite(int x, int y);
+
+        /**
+         * @brief Indica si x e y pertenecen a la misma componente.
+         * @param x índice del primer elemento
+         * @param y índice del segundo elemento
+         * @return true si comparten representante
+         */
+        inline bool same(int x, int y) { return find(x) == find(y); }
+
+        /**
+         * @brief Devuelve el número de componentes actuales.
+         * @return número de componentes
+         */
+        inline int components(void) const { return components_; }
+
+        /**
+         * @brief Devuelve el número de elementos de la componente de x.
+         * @param x índice del elemento
+         * @return tamaño de la componente
+         */
+        inline int component_size(int x) { return size_[find(x)]; }
+
+        /**
+         * @brief Número de búsquedas realizadas desde el último reset.
+         * @return contador de find
+         */
+        inline std::uint64_t find_count(void) const { return finds_; }
+
+        /**
+         * @brief Número de uniones realizadas desde el último reset.
+         * @return contador de uniones
+         */
+        inline std::uint64_t union_count(void) const { return unions_; }
+    };
+}
@@ -0,0 +1,116 @@
+/**
+ * @file distance_kernel.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación del núcleo de distancias al cuadrado.
+ */
+
+#include "distance_kernel.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Sin -mavx2 el núcleo AVX2 se compila aparte y se elige en tiempo de ejecución
+#if !defined(__AVX2__) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define EMST_AVX2_DISPATCH 1
+#endif
+
+namespace EMST
+{
+    namespace
+    {
+        /**
+         * @brief Resto del bloque (o todo, sin SIMD) desde la posición k.
+         */
+        inline void squared_distances_tail(const double *xs, const double *ys, double x, double y, int k,
+                                           int count, double *out)
+        {
+            for (; k < count; ++k)
+            {
+                const double dx = xs[k] - x;
+                const double dy = ys[k] - y;
+
+                out[k] = dx * dx + dy * dy;
+            }
+        }
+
+#if defined(__AVX2__) || defined(EMST_AVX2_DISPATCH)
+        /**
+         * @brief Versión AVX2: 4 parejas por instrucción.
+         */
+#if defined(EMST_AVX2_DISPATCH)
+        __attribute__((target("avx2")))
+#endif
+        void squared_distances_avx2(const double *xs, const double *ys, double x, double y, int count, double *out)
+        {
+            int k = 0;
+            const __m256d vx = _mm256_set1_pd(x);
+            const __m256d vy = _mm256_set1_pd(y);
+
+            for (; k + 4 <= count; k += 4)
+            {
+                const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + k), vx);
+                const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + k), vy);
+
+                _mm256_storeu_pd(out + k, _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+            }
+
+            squared_distances_tail(xs, ys, x, y, k, count, out);
+        }
+#endif
+
+#if !defined(__AVX2__)
+        /**
+         * @brief Versión base: SSE2 (2 parejas por instrucción) o escalar.
+         */
+        void squared_distances_base(const double *xs, const double *ys, double x, double y, int count, double *out)
+        {
+            int k = 0;
+
+#if defined(__SSE2__)
+            const __m128d vx = _mm_set1_pd(x);
+            const __m128d vy = _mm_set1_pd(y);
+
+            for (; k + 2 <= count; k += 2)
+            {
+                const __m128d dx = _mm_sub_pd(_mm_loadu_pd(xs + k), vx);
+                const __m128d dy = _mm_sub_pd(_mm_loadu_pd(ys + k), vy);
+
+                _mm_storeu_pd(out + k, _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+            }
+#endif
+
+            squared_distances_tail(xs, ys, x, y, k, count, out);
+        }
+#endif
+    }
+
+    /**
+     * @brief Distancias al cuadrado de (x, y) a un bloque de puntos en formato SoA.
+     * @param xs coordenadas x del bloque
+     * @param ys coordenadas y del bloque
+     * @param x coordenada x del punto de referencia
+     * @param y coordenada y del punto de referencia
+     * @param count número de puntos del bloque
+     * @param out distancias al cuadrado (salida)
+     */
+    void squared_distances(const double *xs, const double *ys, double x, double y, int count, double *out)
+    {
+#if defined(__AVX2__)
+        squared_distances_avx2(xs, ys, x, y, count, out);
+#elif defined(EMST_AVX2_DISPATCH)
+        using kernel = void (*)(const double *, const double *, double, double, int, double *);
+
+        // La CPU se consulta una sola vez
+        static const kernel selected = []() -> kernel
+        {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? squared_distances_avx2 : squared_distances_base;
+        }();
+
+        selected(xs, ys, x, y, count, out);
+#else
+        squared_distances_base(xs, ys, x, y, count, out);
+#endif
+    }
+}
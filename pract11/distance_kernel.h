@@ -0,0 +1,26 @@
+/**
+ * @file distance_kernel.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Núcleo vectorizado (AVX2/SSE2, con alternativa escalar) de distancias al cuadrado.
+ *
+ * Trabaja sobre una copia estructura-de-vectores (xs, ys) de las coordenadas,
+ * calculando la distancia al cuadrado de un punto a un bloque de puntos
+ * consecutivos con varias parejas por instrucción. En x86 sin -mavx2 la versión
+ * AVX2 se elige en tiempo de ejecución si la CPU la admite.
+ */
+
+#pragma once
+
+namespace EMST
+{
+    /**
+     * @brief Calcula out[k] = (xs[k] - x)^2 + (ys[k] - y)^2 para k en [0, count).
+     * @param xs coordenadas x del bloque
+     * @param ys coordenadas y del bloque
+     * @param x coordenada x del punto de referencia
+     * @param y coordenada y del punto de referencia
+     * @param count número de puntos del bloque
+     * @param out distancias al cuadrado (salida)
+     */
+    void squared_distances(const double *xs, const double *ys, double x, double y, int count, double *out);
+}
@@ -0,0 +1,225 @@
+/**
+ * @file edge_spill.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de los tramos de aristas en disco.
+ */
+
+#include "edge_spill.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include <unistd.h>
+
+namespace EMST
+{
+    // Mínimo de aristas por búfer de tramo durante la mezcla
+    static const std::size_t MIN_RUN_BUFFER = 256;
+
+    /**
+     * @brief Constructor: el fichero se crea con el primer tramo.
+     * @param dir directorio temporal
+     * @param order orden de las aristas
+     */
+    edge_spill::edge_spill(const std::string &dir, const CyA::arc_order &order) : dir_(dir.empty() ? "/tmp" : dir),
+                                                                                  order_(order),
+                                                                                  fd_(-1),
+                                                                                  bytes_(0),
+                                                                                  runs_(),
+                                                                                  heap_(),
+                                                                                  error_()
+    {
+    }
+
+    /**
+     * @brief Destructor: al cerrar el descriptor el sistema libera el fichero borrado.
+     */
+    edge_spill::~edge_spill(void)
+    {
+        if (fd_ >= 0)
+        {
+            close(fd_);
+        }
+    }
+
+    /**
+     * @brief Escribe el tramo ordenado al final del fichero temporal.
+     * @param sorted aristas ordenadas
+     * @return false si falla la creación o la escritura
+     */
+    bool edge_spill::append(const CyA::index_arc_vector &sorted)
+    {
+        if (fd_ < 0)
+        {
+            std::string path = dir_ + "/emst-edges-XXXXXX";
+            fd_ = mkstemp(&path[0]);
+
+            if (fd_ < 0)
+            {
+                error_ = dir_ + ": " + std::strerror(errno);
+                return false;
+            }
+
+            // Sin nombre: desaparece al cerrar aunque el proceso termine mal
+            unlink(path.c_str());
+        }
+
+        run r;
+        r.offset = bytes_;
+        r.left = sorted.size();
+        r.position = 0;
+
+        const char *data = reinterpret_cast<const char *>(sorted.data());
+        std::size_t remaining = sorted.size() * sizeof(CyA::weighted_index_arc);
+
+        while (remaining > 0)
+        {
+            const ssize_t w = pwrite(fd_, data, remaining, static_cast<off_t>(bytes_));
+
+            if (w < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                error_ = std::string("escritura del tramo: ") + std::strerror(errno);
+                return false;
+            }
+
+            data += w;
+            remaining -= static_cast<std::size_t>(w);
+            bytes_ += static_cast<std::uint64_t>(w);
+        }
+
+        runs_.push_back(std::move(r));
+        return true;
+    }
+
+    /**
+     * @brief Carga el primer bloque de cada tramo y construye el montículo.
+     * @param budget bytes para todos los búferes
+     * @return false si falla la lectura
+     */
+    bool edge_spill::start_merge(std::size_t budget)
+    {
+        const std::size_t per_run = runs_.empty() ? 0 :
+            std::max(MIN_RUN_BUFFER, budget / sizeof(CyA::weighted_index_arc) / runs_.size());
+
+        heap_.clear();
+
+        for (std::size_t k = 0; k < runs_.size(); ++k)
+        {
+            run &r = runs_[k];
+            r.buffer.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(per_run, r.left)));
+
+            if (!refill(r))
+            {
+                return false;
+            }
+
+            if (!r.buffer.empty())
+            {
+                heap_.push_back(static_cast<std::uint32_t>(k));
+            }
+        }
+
+        std::make_heap(heap_.begin(), heap_.end(), [this](std::uint32_t a, std::uint32_t b) { return later(a, b); });
+        return true;
+    }
+
+    /**
+     * @brief Extrae la menor arista actual y avanza su tramo.
+     *
+     * Si falla la lectura del siguiente bloque la arista extraída se entrega
+     * igualmente: se vacía el montículo y es la llamada siguiente la que
+     * devuelve false, con error() ya relleno.
+     * @param a arista (salida)
+     * @return false si no quedan aristas o si falló una lectura anterior
+     */
+    bool edge_spill::next(CyA::weighted_index_arc &a)
+    {
+        if (heap_.empty())
+        {
+            return false;
+        }
+
+        auto cmp = [this](std::uint32_t x, std::uint32_t y) { return later(x, y); };
+
+        std::pop_heap(heap_.begin(), heap_.end(), cmp);
+        const std::uint32_t k = heap_.back();
+        run &r = runs_[k];
+
+        a = r.buffer[r.position++];
+
+        if (r.position == r.buffer.size() && !refill(r))
+        {
+            heap_.clear();
+            return true;
+        }
+
+        if (r.position < r.buffer.size())
+        {
+            std::push_heap(heap_.begin(), heap_.end(), cmp);
+        }
+        else
+        {
+            heap_.pop_back();
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Lee el siguiente bloque del tramo (vacío si se ha agotado).
+     * @param r tramo
+     * @return false si falla la lectura
+     */
+    bool edge_spill::refill(run &r)
+    {
+        const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(r.buffer.capacity(), r.left));
+
+        r.buffer.resize(count);
+        r.position = 0;
+
+        char *data = reinterpret_cast<char *>(r.buffer.data());
+        std::size_t remaining = count * sizeof(CyA::weighted_index_arc);
+
+        while (remaining > 0)
+        {
+            const ssize_t got = pread(fd_, data, remaining, static_cast<off_t>(r.offset));
+
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (got <= 0)
+            {
+                error_ = std::string("lectura del tramo: ") + (got < 0 ? std::strerror(errno) : "fin de fichero inesperado");
+                return false;
+            }
+
+            data += got;
+            remaining -= static_cast<std::size_t>(got);
+            r.offset += static_cast<std::uint64_t>(got);
+        }
+
+        r.left -= count;
+        return true;
+    }
+
+    /**
+     * @brief Orden del montículo de mínimos: a va después de b.
+     */
+    bool edge_spill::later(std::uint32_t a, std::uint32_t b) const
+    {
+        const run &ra = runs_[a];
+        const run &rb = runs_[b];
+
+        return order_(rb.buffer[rb.position], ra.buffer[ra.position]);
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ * @file edge_spill.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Tramos ordenados de aristas en disco y su mezcla k-aria (Kruskal externo).
+ *
+ * Todos los tramos se escriben uno tras otro en un único fichero temporal
+ * (borrado nada más crearse), de modo que el número de tramos no está limitado
+ * por los descriptores abiertos. La mezcla lee cada tramo por bloques con
+ * pread y entrega las aristas en el orden global de arc_order.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "point_types.h"
+
+namespace EMST
+{
+    /**
+     * @class edge_spill
+     * @brief Fichero temporal de tramos ordenados con lectura mezclada.
+     */
+    class edge_spill
+    {
+    private:
+        /**
+         * @brief Tramo en el fichero y estado de su lectura.
+         */
+        struct run
+        {
+            std::uint64_t offset;   // posición de la siguiente arista por leer (bytes)
+            std::uint64_t left;     // aristas que quedan en disco
+            std::vector<CyA::weighted_index_arc> buffer;
+            std::size_t position;   // siguiente arista de buffer
+        };
+
+        std::string dir_;
+        CyA::arc_order order_;
+        int fd_;
+        std::uint64_t bytes_;
+        std::vector<run> runs_;
+        std::vector<std::uint32_t> heap_; // índices de tramos ordenados por su arista actual
+        std::string error_;
+
+    public:
+        /**
+         * @brief Prepara los tramos en el directorio dir (no crea nada todavía).
+         * @param dir directorio de los ficheros temporales
+         * @param order orden de las aristas de todos los tramos
+         */
+        edge_spill(const std::string &dir, const CyA::arc_order &order);
+
+        /**
+         * @brief Destructor: cierra (y con ello libera) el fichero temporal.
+         */
+        ~edge_spill(void);
+
+        edge_spill(const edge_spill &) = delete;
+        edge_spill& operator=(const edge_spill &) = delete;
+
+        /**
+         * @brief Añade un tramo ya ordenado al final del fichero.
+         * @param sorted aristas ordenadas por order
+         * @return false si no se pudo crear o escribir el fichero (ver error())
+         */
+        bool append(const CyA::index_arc_vector &sorted);
+
+        /**
+         * @brief Prepara la mezcla repartiendo budget bytes entre los búferes de los tramos.
+         * @param budget memoria disponible para la lectura (bytes)
+         * @return false si falla la lectura inicial
+         */
+        bool start_merge(std::size_t budget);
+
+        /**
+         * @brief Extrae la siguiente arista en orden global.
+         *
+         * Un fallo de lectura no descarta la arista ya extraída: se informa en
+         * la llamada siguiente, que devuelve false con error() no vacío.
+         * @param a arista (salida)
+         * @return false cuando no quedan aristas o si falló la lectura (ver error())
+         */
+        bool next(CyA::weighted_index_arc &a);
+
+        /**
+         * @brief Bytes escritos en disco.
+         * @return total de bytes de todos los tramos
+         */
+        inline std::uint64_t bytes_spilled(void) const { return bytes_; }
+
+        /**
+         * @brief Número de tramos escritos.
+         * @return tramos
+         */
+        inline std::size_t runs(void) const { return runs_.size(); }
+
+        /**
+         * @brief Mensaje del último error de E/S (vacío si no hubo).
+         * @return mensaje
+         */
+        inline const std::string& error(void) const { return error_; }
+
+    private:
+        /**
+         * @brief Rellena el búfer del tramo r desde disco.
+         * @return false si falla la lectura
+         */
+        bool refill(run &r);
+
+        /**
+         * @brief Compara los tramos a y b por su arista actual (para el montículo).
+         */
+        bool later(std::uint32_t a, std::uint32_t b) const;
+    };
+}
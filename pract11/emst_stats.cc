@@ -0,0 +1,86 @@
+/**
+ * @file emst_stats.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación del informe --stats.
+ */
+
+#include "emst_stats.h"
+
+#include <sys/resource.h>
+
+namespace EMST
+{
+    /**
+     * @brief Pico de memoria residente (ru_maxrss está en KiB en Linux).
+     * @return kilobytes (0 si no está disponible)
+     */
+    long peak_rss_kb(void)
+    {
+        struct rusage usage;
+
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return 0;
+        }
+
+        return usage.ru_maxrss;
+    }
+
+    namespace
+    {
+        /**
+         * @brief Escribe ,"name":valor con un double en notación fija.
+         */
+        void put_seconds(output_writer &out, const char *name, double value)
+        {
+            out.put(",\"");
+            out.put(name);
+            out.put("\":");
+            out.put_fixed(value, 0, 6);
+        }
+
+        /**
+         * @brief Escribe ,"name":valor con un entero.
+         */
+        void put_count(output_writer &out, const char *name, unsigned long long value)
+        {
+            out.put(",\"");
+            out.put(name);
+            out.put("\":");
+            out.put(value);
+        }
+    }
+
+    /**
+     * @brief Escribe las medidas como JSON.
+     * @param out destino
+     * @param stats medidas
+     */
+    void write_stats(output_writer &out, const emst_stats &stats)
+    {
+        out.put("{\"engine\":\"");
+        out.put(stats.engine);
+        out.put('"');
+
+        put_count(out, "points", stats.points);
+        put_count(out, "duplicates", stats.duplicates);
+        put_count(out, "threads", static_cast<unsigned long long>(stats.threads));
+
+        put_seconds(out, "parse_seconds", stats.parse_seconds);
+        put_seconds(out, "dedup_seconds", stats.dedup_seconds);
+        put_seconds(out, "generate_seconds", stats.generate_seconds);
+        put_seconds(out, "sort_seconds", stats.sort_seconds);
+        put_seconds(out, "mst_seconds", stats.mst_seconds);
+        put_seconds(out, "output_seconds", stats.output_seconds);
+
+        put_count(out, "edges_generated", stats.edges_generated);
+        put_count(out, "edges_scanned", stats.edges_scanned);
+        put_count(out, "finds", stats.finds);
+        put_count(out, "unions", stats.unions);
+        put_count(out, "spilled_bytes", stats.spilled_bytes);
+        put_count(out, "runs", stats.runs);
+        put_count(out, "peak_rss_kb", static_cast<unsigned long long>(stats.peak_rss_kb));
+
+        out.put("}\n");
+    }
+}
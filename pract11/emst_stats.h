@@ -0,0 +1,69 @@
+/**
+ * @file emst_stats.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Tiempos y contadores por fase de una ejecución del EMST (opción --stats).
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "output_writer.h"
+
+namespace EMST
+{
+    /**
+     * @brief Medidas de una ejecución: segundos por fase, contadores y memoria.
+     *
+     * point_set rellena las fases del EMST (generación, ordenación, recorrido);
+     * el programa principal añade la lectura, la salida y el pico de memoria.
+     */
+    struct emst_stats
+    {
+        const char *engine = "";
+        std::uint64_t points = 0;
+        std::uint64_t duplicates = 0;  // puntos repetidos colapsados antes del motor
+        int threads = 1;
+
+        double parse_seconds = 0.0;    // lectura y conversión de la entrada
+        double dedup_seconds = 0.0;    // detección de puntos repetidos
+        double generate_seconds = 0.0; // aristas candidatas (todas las parejas o Delaunay)
+        double sort_seconds = 0.0;     // ordenación de las aristas
+        double mst_seconds = 0.0;      // recorrido Kruskal / Filter-Kruskal / Borůvka / Prim
+        double output_seconds = 0.0;   // escritura del árbol (y del DOT)
+
+        std::uint64_t edges_generated = 0; // aristas candidatas
+        std::uint64_t edges_scanned = 0;   // aristas examinadas hasta completar el árbol
+        std::uint64_t finds = 0;           // búsquedas en el disjoint_set
+        std::uint64_t unions = 0;          // uniones realizadas
+
+        std::uint64_t spilled_bytes = 0;   // bytes escritos en disco (Kruskal externo)
+        std::uint64_t runs = 0;            // tramos ordenados escritos
+
+        long peak_rss_kb = 0;              // pico de memoria residente del proceso
+    };
+
+    /**
+     * @brief Segundos transcurridos desde start.
+     * @param start instante inicial
+     * @return segundos (double)
+     */
+    inline double seconds_since(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * @brief Pico de memoria residente del proceso (getrusage).
+     * @return kilobytes
+     */
+    long peak_rss_kb(void);
+
+    /**
+     * @brief Escribe las medidas como un objeto JSON en una línea.
+     * @param out destino
+     * @param stats medidas
+     */
+    void write_stats(output_writer &out, const emst_stats &stats);
+}
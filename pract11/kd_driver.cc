@@ -0,0 +1,145 @@
+/**
+ * @file kd_driver.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Instancias de kd_point_set para las dimensiones 1..KD_MAX_DIM, las tres métricas
+ *        y las dos precisiones.
+ */
+
+#include "kd_driver.h"
+#include "kd_point_set.h"
+
+#include <cmath>
+
+namespace EMST
+{
+    namespace
+    {
+        /**
+         * @brief Resuelve con la instancia <D, Metric, T>.
+         */
+        template <int D, class Metric, class T>
+        bool solve(const kd_options &opt, const std::vector<double> &coords,
+                   output_writer *out, double &cost, std::string &error)
+        {
+            if (!kd_point_set<D, Metric, T>::supports(opt.algorithm))
+            {
+                error = std::string("el motor ") + engine_name(opt.algorithm) + " solo está disponible en 2D euclídeo";
+                return false;
+            }
+
+            kd_point_set<D, Metric, T> ps(coords);
+            ps.set_threads(opt.threads);
+            ps.EMST(opt.algorithm);
+
+            cost = ps.get_cost();
+            if (out != nullptr)
+            {
+                ps.write_tree(*out);
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Elige la precisión para la dimensión y métrica dadas.
+         */
+        template <int D, class Metric>
+        bool solve_precision(const kd_options &opt, const std::vector<double> &coords,
+                             output_writer *out, double &cost, std::string &error)
+        {
+            return opt.single ? solve<D, Metric, float>(opt, coords, out, cost, error)
+                              : solve<D, Metric, double>(opt, coords, out, cost, error);
+        }
+
+        /**
+         * @brief Elige la métrica para la dimensión D.
+         */
+        template <int D>
+        bool solve_metric(const kd_options &opt, const std::vector<double> &coords,
+                          output_writer *out, double &cost, std::string &error)
+        {
+            switch (opt.metric)
+            {
+            case metric_kind::squared:
+                return solve_precision<D, metric::squared_euclidean>(opt, coords, out, cost, error);
+            case metric_kind::manhattan:
+                return solve_precision<D, metric::manhattan>(opt, coords, out, cost, error);
+            case metric_kind::euclidean:
+                break;
+            }
+
+            return solve_precision<D, metric::euclidean>(opt, coords, out, cost, error);
+        }
+
+        /**
+         * @brief Busca recursivamente la instancia D == opt.dim entre D y KD_MAX_DIM.
+         */
+        template <int D>
+        bool solve_dim(const kd_options &opt, const std::vector<double> &coords,
+                       output_writer *out, double &cost, std::string &error)
+        {
+            if (opt.dim == D)
+            {
+                return solve_metric<D>(opt, coords, out, cost, error);
+            }
+
+            if constexpr (D < KD_MAX_DIM)
+            {
+                return solve_dim<D + 1>(opt, coords, out, cost, error);
+            }
+
+            error = "dimensión no soportada: " + std::to_string(opt.dim) + " (1.." + std::to_string(KD_MAX_DIM) + ")";
+            return false;
+        }
+    }
+
+    /**
+     * @brief Convierte un nombre en una métrica.
+     * @param name nombre
+     * @param m métrica (salida)
+     * @return true si el nombre es válido
+     */
+    bool parse_metric(const std::string &name, metric_kind &m)
+    {
+        if (name == "euclidean")
+        {
+            m = metric_kind::euclidean;
+        }
+        else if (name == "squared")
+        {
+            m = metric_kind::squared;
+        }
+        else if (name == "manhattan")
+        {
+            m = metric_kind::manhattan;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Despacha a la instancia kd_point_set<dim, métrica, precisión>.
+     * @return false si la dimensión o el motor no están disponibles
+     */
+    bool solve_kd(const kd_options &opt, const std::vector<double> &coords,
+                  output_writer *out, double &cost, std::string &error)
+    {
+        return solve_dim<1>(opt, coords, out, cost, error);
+    }
+
+    /**
+     * @brief Cota de la diferencia de coste entre float y double.
+     * @return tolerancia absoluta
+     */
+    double float_cost_tolerance(std::size_t n, int dim, double max_abs, double cost)
+    {
+        const double per_edge = 2.0 * dim * max_abs * std::ldexp(1.0, -24);
+        const double edges = n > 0 ? static_cast<double>(n - 1) : 0.0;
+
+        return edges * per_edge + FLOAT_COST_TOLERANCE * cost;
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file kd_driver.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Selección en tiempo de ejecución de la instancia kd_point_set<D, Metric, T>.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "point_set.h"
+#include "output_writer.h"
+
+// Mayor dimensión instanciada para --dim
+#define KD_MAX_DIM 16
+
+// Tolerancia relativa del coste en precisión simple (véase float_cost_tolerance)
+#define FLOAT_COST_TOLERANCE 1e-5
+
+namespace EMST
+{
+    /**
+     * @brief Métricas disponibles para --metric.
+     */
+    enum class metric_kind
+    {
+        euclidean, ///< distancia euclídea (por defecto)
+        squared,   ///< distancia euclídea al cuadrado
+        manhattan  ///< distancia L1
+    };
+
+    /**
+     * @brief Parámetros de una ejecución de kd_point_set.
+     */
+    struct kd_options
+    {
+        int dim = 2;
+        metric_kind metric = metric_kind::euclidean;
+        engine algorithm = engine::kruskal;
+        int threads = 1;
+        bool single = false; ///< coordenadas y pesos float (--float)
+    };
+
+    /**
+     * @brief Convierte un nombre ("euclidean", "squared", "manhattan") en una métrica.
+     * @param name nombre
+     * @param m métrica (salida)
+     * @return true si el nombre es válido
+     */
+    bool parse_metric(const std::string &name, metric_kind &m);
+
+    /**
+     * @brief Calcula el EMST de puntos de dimensión opt.dim y lo escribe en out.
+     * @param opt dimensión, métrica, motor (kruskal o prim), hilos y precisión
+     * @param coords n * dim coordenadas, punto a punto
+     * @param out destino del árbol y el coste (nullptr para no escribir nada)
+     * @param cost coste del árbol (salida)
+     * @param error mensaje de error (salida)
+     * @return false si la dimensión o el motor no están disponibles
+     */
+    bool solve_kd(const kd_options &opt, const std::vector<double> &coords,
+                  output_writer *out, double &cost, std::string &error);
+
+    /**
+     * @brief Diferencia máxima admitida entre el coste en float y en double.
+     *
+     * Redondear cada coordenada a float la mueve como mucho max_abs * 2^-24, así
+     * que la longitud de cada arista cambia como mucho 2 * dim * max_abs * 2^-24
+     * (en L1; menos en L2). El árbol en float puede elegir otra arista entre
+     * candidatas casi empatadas, pero solo si sus pesos difieren menos que ese
+     * error, de modo que la diferencia total está acotada por (n - 1) veces el
+     * error por arista; se añade FLOAT_COST_TOLERANCE * cost por el redondeo de
+     * los pesos calculados en float. Con la métrica "squared" el error por
+     * arista escala con la extensión y la cota es solo orientativa.
+     * @param n número de puntos
+     * @param dim dimensión
+     * @param max_abs mayor valor absoluto de las coordenadas
+     * @param cost coste en double
+     * @return tolerancia absoluta
+     */
+    double float_cost_tolerance(std::size_t n, int dim, double max_abs, double cost);
+}
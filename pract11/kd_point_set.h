@@ -0,0 +1,337 @@
+/**
+ * @file kd_point_set.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Plantilla kd_point_set<D, Metric>: EMST de puntos de dimensión D fija.
+ *
+ * point_set sigue siendo el caso 2D euclídeo (con Delaunay, Borůvka y el núcleo
+ * SIMD). Para otras dimensiones o métricas se instancia esta plantilla: la
+ * dimensión es una constante de compilación, así que el bucle de distancia de
+ * cada instancia tiene un número fijo de iteraciones y el compilador lo
+ * desenrolla. Solo dispone de los motores que no dependen del plano: Kruskal
+ * sobre todas las parejas y Prim denso.
+ *
+ * El tipo de coordenada T puede ser float (--float): puntos y pesos de las
+ * aristas ocupan la mitad (aristas de 12 bytes en lugar de 16) y caben más
+ * puntos en caché y en memoria. El coste se acumula siempre en double.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "point_types.h"
+#include "point_set.h"
+#include "disjoint_set.h"
+#include "parallel_sort.h"
+#include "output_writer.h"
+
+namespace EMST
+{
+    /**
+     * @brief Punto de dimensión D con coordenadas de tipo T.
+     */
+    template <int D, class T = double>
+    using kd_point = std::array<T, D>;
+
+    /**
+     * @brief Políticas de métrica.
+     *
+     * key<R>() es una clave monótona con la distancia, acumulada en el tipo R
+     * (el de las coordenadas para los pesos de las aristas, double para el
+     * coste), y distance() la convierte en la distancia que se suma al coste.
+     */
+    namespace metric
+    {
+        /**
+         * @brief Distancia euclídea (clave: distancia al cuadrado).
+         */
+        struct euclidean
+        {
+            template <class R, class T, std::size_t D>
+            static inline R key(const std::array<T, D> &a, const std::array<T, D> &b)
+            {
+                R sum = 0;
+                for (std::size_t k = 0; k < D; ++k)
+                {
+                    const R d = static_cast<R>(a[k]) - static_cast<R>(b[k]);
+                    sum += d * d;
+                }
+                return sum;
+            }
+
+            static inline double distance(double key) { return std::sqrt(key); }
+        };
+
+        /**
+         * @brief Distancia euclídea al cuadrado (mismo árbol, el coste suma cuadrados).
+         */
+        struct squared_euclidean
+        {
+            template <class R, class T, std::size_t D>
+            static inline R key(const std::array<T, D> &a, const std::array<T, D> &b)
+            {
+                return euclidean::key<R>(a, b);
+            }
+
+            static inline double distance(double key) { return key; }
+        };
+
+        /**
+         * @brief Distancia Manhattan (L1).
+         */
+        struct manhattan
+        {
+            template <class R, class T, std::size_t D>
+            static inline R key(const std::array<T, D> &a, const std::array<T, D> &b)
+            {
+                R sum = 0;
+                for (std::size_t k = 0; k < D; ++k)
+                {
+                    sum += std::fabs(static_cast<R>(a[k]) - static_cast<R>(b[k]));
+                }
+                return sum;
+            }
+
+            static inline double distance(double key) { return key; }
+        };
+    }
+
+    /**
+     * @class kd_point_set
+     * @brief Conjunto de puntos D-dimensionales con el cálculo de su EMST.
+     *
+     * Misma interfaz que point_set (EMST, get_index_tree, get_cost, write_tree)
+     * y mismas aristas compactas: peso = Metric::key en el tipo T, extremos por índice.
+     */
+    template <int D, class Metric = metric::euclidean, class T = double>
+    class kd_point_set : public std::vector<kd_point<D, T>>
+    {
+        static_assert(D >= 1, "la dimensión debe ser positiva");
+
+    public:
+        typedef kd_point<D, T> point;
+        typedef CyA::basic_weighted_index_arc<T> arc;
+
+    private:
+        CyA::index_tree emst_;
+        std::vector<arc> arcs_;
+        int threads_;
+
+    public:
+
+        /**
+         * @brief Construye el conjunto a partir de n * D coordenadas consecutivas.
+         * @param coords coordenadas (punto a punto)
+         */
+        explicit kd_point_set(const std::vector<double> &coords) : std::vector<point>(coords.size() / D),
+                                                                     emst_(),
+                                                                     arcs_(),
+                                                                     threads_(1)
+        {
+            for (size_t i = 0; i < this->size(); ++i)
+            {
+                for (int k = 0; k < D; ++k)
+                {
+                    (*this)[i][k] = static_cast<T>(coords[i * D + k]);
+                }
+            }
+        }
+
+        /**
+         * @brief Número de hilos para generar y ordenar las aristas.
+         * @param threads número de hilos (>= 1)
+         */
+        inline void set_threads(int threads) { threads_ = threads > 1 ? threads : 1; }
+
+        /**
+         * @brief Indica si el motor está disponible fuera del plano.
+         * @param e motor
+         * @return true para kruskal y prim
+         */
+        static inline bool supports(engine e)
+        {
+            return e == engine::kruskal || e == engine::prim;
+        }
+
+        /**
+         * @brief Calcula el EMST con el motor indicado (debe cumplir supports(e)).
+         * @param e motor
+         */
+        void EMST(engine e = engine::kruskal)
+        {
+            const int n = static_cast<int>(this->size());
+
+            emst_.clear();
+            emst_.reserve(n > 0 ? n - 1 : 0);
+
+            if (e == engine::prim)
+            {
+                prim();
+                return;
+            }
+
+            // Todas las parejas i < j con su clave de distancia
+            arcs_.clear();
+            arcs_.reserve(n > 1 ? static_cast<size_t>(n) * (n - 1) / 2 : 0);
+
+            for (int i = 0; i < n; ++i)
+            {
+                const point &p = (*this)[i];
+                for (int j = i + 1; j < n; ++j)
+                {
+                    arcs_.emplace_back(Metric::template key<T>(p, (*this)[j]), i, j);
+                }
+            }
+
+            parallel_sort(arcs_, threads_);
+
+            disjoint_set ds(n);
+            for (const arc &a : arcs_)
+            {
+                if (ds.components() <= 1)
+                {
+                    break;
+                }
+
+                if (ds.unite(a.i, a.j))
+                {
+                    emst_.emplace_back(a.i, a.j);
+                }
+            }
+        }
+
+        /**
+         * @brief Devuelve las aristas del EMST como pares de índices.
+         * @return referencia constante al árbol
+         */
+        inline const CyA::index_tree& get_index_tree(void) const { return emst_; }
+
+        /**
+         * @brief Coste del EMST con la métrica de la instancia.
+         * @return suma de las distancias de las aristas del árbol
+         */
+        double get_cost(void) const
+        {
+            double sum = 0.0;
+            for (const CyA::index_arc &a : emst_)
+            {
+                sum += Metric::distance(Metric::template key<double>((*this)[a.first], (*this)[a.second]));
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Escribe el árbol como "(x1, ..., xD) -> (y1, ..., yD)" y el coste final.
+         * @param out destino
+         */
+        void write_tree(output_writer &out) const
+        {
+            for (const CyA::index_arc &a : emst_)
+            {
+                put_point(out, (*this)[a.first]);
+                out.put(" -> ");
+                put_point(out, (*this)[a.second]);
+                out.put('\n');
+            }
+
+            out.put_fixed(get_cost(), 0, 2);
+            out.put('\n');
+        }
+
+    private:
+        /**
+         * @brief Prim denso: distancia de cada punto al árbol, sin lista de aristas.
+         *
+         * Los empates se deciden con el orden (clave, i, j) de las aristas de
+         * Kruskal, así que ambos motores devuelven el mismo árbol; al final las
+         * aristas se ordenan igual que las acepta Kruskal.
+         */
+        void prim(void)
+        {
+            const int n = static_cast<int>(this->size());
+
+            if (n == 0)
+            {
+                return;
+            }
+
+            std::vector<T> dist(n);
+            std::vector<int> parent(n, 0);
+            std::vector<char> in_tree(n, 0);
+
+            in_tree[0] = 1;
+            for (int k = 1; k < n; ++k)
+            {
+                dist[k] = Metric::template key<T>((*this)[0], (*this)[k]);
+            }
+
+            // Arista (parent[k], k) del punto k al árbol, como la ordena Kruskal
+            auto edge = [&parent](int k) { return std::make_pair(std::min(parent[k], k), std::max(parent[k], k)); };
+
+            for (int added = 1; added < n; ++added)
+            {
+                int best = -1;
+                for (int k = 1; k < n; ++k)
+                {
+                    if (!in_tree[k] &&
+                        (best == -1 || dist[k] < dist[best] || (dist[k] == dist[best] && edge(k) < edge(best))))
+                    {
+                        best = k;
+                    }
+                }
+
+                in_tree[best] = 1;
+                emst_.emplace_back(std::min(parent[best], best), std::max(parent[best], best));
+
+                const point &v = (*this)[best];
+                for (int k = 1; k < n; ++k)
+                {
+                    if (!in_tree[k])
+                    {
+                        const T d = Metric::template key<T>(v, (*this)[k]);
+                        if (d < dist[k] ||
+                            (d == dist[k] && std::make_pair(std::min(best, k), std::max(best, k)) < edge(k)))
+                        {
+                            dist[k] = d;
+                            parent[k] = best;
+                        }
+                    }
+                }
+            }
+
+            std::vector<arc> accepted;
+            accepted.reserve(emst_.size());
+            for (const CyA::index_arc &a : emst_)
+            {
+                accepted.emplace_back(Metric::template key<T>((*this)[a.first], (*this)[a.second]), a.first, a.second);
+            }
+            std::sort(accepted.begin(), accepted.end());
+
+            for (std::size_t k = 0; k < accepted.size(); ++k)
+            {
+                emst_[k] = CyA::index_arc(accepted[k].i, accepted[k].j);
+            }
+        }
+
+        /**
+         * @brief Escribe un punto con el mismo ancho y precisión que la salida 2D.
+         */
+        static void put_point(output_writer &out, const point &p)
+        {
+            out.put('(');
+            for (int k = 0; k < D; ++k)
+            {
+                if (k > 0)
+                {
+                    out.put(", ");
+                }
+                out.put_fixed(static_cast<double>(p[k]), MAX_SZ, MAX_PREC);
+            }
+            out.put(')');
+        }
+    };
+}
@@ -0,0 +1,121 @@
+/**
+ * @file kd_tree.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación del kd-tree.
+ */
+
+#include "kd_tree.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace EMST
+{
+    /**
+     * @brief Constructor: inicializa la permutación identidad y construye el árbol.
+     * @param points vector de puntos
+     * @param leaf_size número máximo de puntos por hoja
+     */
+    kd_tree::kd_tree(const CyA::point_vector &points, int leaf_size) : points_(points),
+                                                                       index_(points.size()),
+                                                                       nodes_(),
+                                                                       leaf_size_(std::max(leaf_size, 1))
+    {
+        const int n = static_cast<int>(points_.size());
+
+        for (int i = 0; i < n; ++i)
+        {
+            index_[i] = i;
+        }
+
+        // Un árbol binario con hojas de leaf_size puntos tiene menos de 2n/leaf_size nodos
+        nodes_.reserve(2 * (n / leaf_size_ + 1));
+
+        if (n > 0)
+        {
+            build(0, n);
+        }
+    }
+
+    /**
+     * @brief Destructor vacío.
+     */
+    kd_tree::~kd_tree(void)
+    {
+    }
+
+    /**
+     * @brief Crea el nodo del rango [begin, end) y divide por la mediana si no es hoja.
+     * @param begin inicio del rango en index_
+     * @param end fin del rango en index_
+     * @return índice del nodo creado
+     */
+    int kd_tree::build(int begin, int end)
+    {
+        const int id = static_cast<int>(nodes_.size());
+
+        kd_node node;
+        node.min_x = std::numeric_limits<double>::infinity();
+        node.min_y = std::numeric_limits<double>::infinity();
+        node.max_x = -std::numeric_limits<double>::infinity();
+        node.max_y = -std::numeric_limits<double>::infinity();
+        node.begin = begin;
+        node.end = end;
+        node.left = -1;
+        node.right = -1;
+
+        // Caja envolvente de los puntos del rango
+        for (int k = begin; k < end; ++k)
+        {
+            const CyA::point &p = points_[index_[k]];
+
+            node.min_x = std::min(node.min_x, p.first);
+            node.min_y = std::min(node.min_y, p.second);
+            node.max_x = std::max(node.max_x, p.first);
+            node.max_y = std::max(node.max_y, p.second);
+        }
+
+        nodes_.push_back(node);
+
+        if (end - begin <= leaf_size_)
+        {
+            return id;
+        }
+
+        // Partir por la mediana de la dimensión con mayor extensión
+        const int mid = begin + (end - begin) / 2;
+        const bool split_x = (node.max_x - node.min_x) >= (node.max_y - node.min_y);
+
+        std::nth_element(index_.begin() + begin, index_.begin() + mid, index_.begin() + end,
+                         [&](int a, int b) {
+                             return split_x ? points_[a].first < points_[b].first
+                                            : points_[a].second < points_[b].second;
+                         });
+
+        const int left = build(begin, mid);
+        const int right = build(mid, end);
+
+        nodes_[id].left = left;
+        nodes_[id].right = right;
+
+        return id;
+    }
+
+    /**
+     * @brief Cuadrado de la distancia mínima entre las cajas de los nodos a y b.
+     * @param a índice del primer nodo
+     * @param b índice del segundo nodo
+     * @return distancia al cuadrado
+     */
+    double kd_tree::min_distance(int a, int b) const
+    {
+        const kd_node &na = nodes_[a];
+        const kd_node &nb = nodes_[b];
+
+        // Separación en cada eje (0 si los intervalos se solapan)
+        const double dx = std::max(0.0, std::max(na.min_x - nb.max_x, nb.min_x - na.max_x));
+        const double dy = std::max(0.0, std::max(na.min_y - nb.max_y, nb.min_y - na.max_y));
+
+        return dx * dx + dy * dy;
+    }
+}
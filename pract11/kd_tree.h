@@ -0,0 +1,94 @@
+/**
+ * @file kd_tree.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Declaración de la clase kd_tree: índice espacial sobre los índices de los puntos.
+ *
+ * Cada nodo guarda la caja envolvente de sus puntos y un rango [begin, end)
+ * del vector de índices permutado, de modo que las hojas son rangos contiguos.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "point_types.h"
+
+namespace EMST
+{
+    /**
+     * @brief Nodo del kd-tree: caja envolvente, rango de índices e hijos (-1 en las hojas).
+     */
+    struct kd_node
+    {
+        double min_x;
+        double min_y;
+        double max_x;
+        double max_y;
+        int begin;
+        int end;
+        int left;
+        int right;
+
+        /**
+         * @brief Indica si el nodo es una hoja.
+         * @return true si no tiene hijos
+         */
+        inline bool is_leaf(void) const { return left == -1; }
+    };
+
+    /**
+     * @class kd_tree
+     * @brief kd-tree 2D construido por mediana sobre la dimensión de mayor extensión.
+     *
+     * No copia los puntos: guarda una referencia al point_vector y una permutación
+     * de sus índices. El nodo 0 es la raíz y cada hijo se almacena después de su padre.
+     */
+    class kd_tree
+    {
+    private:
+        const CyA::point_vector &points_;
+        std::vector<int> index_;
+        std::vector<kd_node> nodes_;
+        int leaf_size_;
+
+    public:
+        /**
+         * @brief Construye el árbol sobre el vector de puntos.
+         * @param points vector de puntos (se guarda una referencia)
+         * @param leaf_size número máximo de puntos por hoja
+         */
+        explicit kd_tree(const CyA::point_vector &points, int leaf_size = 8);
+
+        /**
+         * @brief Destructor.
+         */
+        ~kd_tree(void);
+
+        /**
+         * @brief Devuelve los nodos del árbol (el 0 es la raíz).
+         * @return referencia constante al vector de nodos
+         */
+        inline const std::vector<kd_node>& get_nodes(void) const { return nodes_; }
+
+        /**
+         * @brief Devuelve la permutación de índices de puntos que ordenan las hojas.
+         * @return referencia constante al vector de índices
+         */
+        inline const std::vector<int>& get_index(void) const { return index_; }
+
+        /**
+         * @brief Cuadrado de la distancia mínima entre las cajas de dos nodos.
+         * @param a índice del primer nodo
+         * @param b índice del segundo nodo
+         * @return distancia al cuadrado (0 si las cajas se solapan)
+         */
+        double min_distance(int a, int b) const;
+
+    private:
+        /**
+         * @brief Construye recursivamente el subárbol del rango [begin, end).
+         * @return índice del nodo creado
+         */
+        int build(int begin, int end);
+    };
+}
@@ -1,12 +1,35 @@
 /**
  * @file main.cc
  * @author Daniel Palenzuela Álvarez alu0101140469
- * @brief Programa principal. Lee puntos desde stdin, calcula EMST y escribe por stdout.
+ * @brief Programa principal. Lee puntos desde stdin (o -i), calcula EMST y escribe por stdout.
  *
  * Uso:
  *   ./emst # lee desde stdin y escribe aristas + coste a stdout
  *   ./emst < input1.txt > output1.txt # introducir puntos desde fichero y guardar salida en fichero
  *   ./emst -d output1.dot < input1.txt  # genera fichero DOT para visualización
+ *   ./emst -a delaunay < input1.txt # usa solo las aristas de la triangulación de Delaunay
+ *   ./emst -a boruvka < input1.txt # Borůvka dual sobre kd-tree, sin lista de aristas
+ *   ./emst -a filter < input1.txt # Filter-Kruskal: ordena solo las aristas necesarias
+ *   ./emst -a prim < input1.txt # Prim denso: O(n) memoria, sin lista de aristas
+ *   ./emst -j 8 < input1.txt # genera y ordena las aristas con 8 hilos
+ *   ./emst -i input1.txt # lee los puntos del fichero (proyectado en memoria)
+ *   ./emst -i input1.txt -c input1.bin # convierte el fichero de texto a formato binario
+ *   ./emst -i input1.bin # lee directamente un fichero binario (se detecta por su firma)
+ *   ./emst --online < input1.txt # inserta los puntos uno a uno actualizando el árbol
+ *   ./emst -b -j 8 < sets.txt # lote: varios conjuntos concatenados resueltos con 8 hilos
+ *   ./emst -b -i dir/ -a delaunay # lote: un conjunto por fichero del directorio
+ *   ./emst --stats < input1.txt # tiempos y contadores por fase en JSON por stderr
+ *   ./emst --dim 3 < puntos3d.txt # puntos "x y z" (Kruskal o Prim, dimensiones 1..16)
+ *   ./emst --metric manhattan < input1.txt # EMST con distancia L1 (también "squared")
+ *   ./emst --external 64 --tmpdir /var/tmp < input1.txt # Kruskal externo con 64 MiB para aristas
+ *   ./emst --approx 0.1 < input1.txt # árbol de coste <= 1.1 veces el óptimo (pares bien separados)
+ *   ./emst --cut 10,25 --clusters 3 < input1.txt # etiquetas de cluster por punto (enlace simple)
+ *   ./emst --cache ~/.cache/emst --cache-size 64 < input1.txt # reutiliza resultados ya calculados (máx. 64 MiB)
+ *   ./emst --serve /tmp/emst.sock -a delaunay -j 4 # servidor residente: 4 peticiones a la vez
+ *   ./emst --client /tmp/emst.sock < input1.txt # envía los puntos al servidor y escribe su respuesta
+ *   ./emst --tiles 8 -j 4 -a delaunay < input1.txt # 8 franjas resueltas por 4 procesos trabajadores
+ *   ./emst --float < input1.txt # coordenadas y pesos en precisión simple
+ *   ./emst --check-float < input1.txt # compara el coste float con el double (estado 1 si excede la tolerancia)
  *   ./neato output1.dot -Tpdf -o salida.pdf # generar PDF con DOT
  */
 
@@ -16,9 +39,29 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "point_types.h"
 #include "point_set.h"
+#include "point_reader.h"
+#include "point_file.h"
+#include "output_writer.h"
+#include "batch.h"
+#include "emst_stats.h"
+#include "kd_driver.h"
+#include "result_cache.h"
+#include "server.h"
+#include "tiling.h"
 
 using namespace std;
 using namespace EMST;
@@ -27,70 +70,186 @@ using namespace EMST;
  * @brief Genera un fichero DOT con el conjunto de puntos y las aristas del árbol.
  * @param filename nombre del fichero DOT a crear
  * @param ps conjunto de puntos (original)
- * @param tree aristas del EMST
+ * @param tree aristas del EMST como pares de índices de puntos
  */
 static void generate_dot(const string &filename,
                          const CyA::point_vector &ps,
-                         const CyA::tree &tree)
+                         const CyA::index_tree &tree)
 {
-    ofstream ofs(filename.c_str());
+    output_writer out(filename);
 
-    if (!ofs)
+    if (!out.good())
     {
         cerr << "ERROR: no se puede abrir fichero DOT para escritura: " << filename << endl;
         return;
     }
 
-    // Cabecera del grafo
-    ofs << "graph{ " << endl << endl;
+    write_dot(out, ps, tree);
+
+    if (!out.flush())
+    {
+        cerr << "ERROR: no se pudo escribir el fichero DOT: " << filename << endl;
+    }
+}
+
+/**
+ * @brief Completa el pico de memoria y escribe las medidas en JSON por stderr.
+ * @param stats medidas de la ejecución
+ */
+static void report_stats(emst_stats &stats)
+{
+    stats.peak_rss_kb = peak_rss_kb();
+
+    output_writer err(2);
+    write_stats(err, stats);
+    err.flush();
+}
+
+/**
+ * @brief Convierte una lista "a,b,c" de números no negativos.
+ * @param text lista separada por comas
+ * @param values valores leídos (se añaden al final)
+ * @return false si algún elemento no es un número no negativo
+ */
+static bool parse_list(const char *text, vector<double> &values)
+{
+    stringstream ss(text);
+    string item;
+
+    while (getline(ss, item, ','))
+    {
+        char *end = nullptr;
+        const double v = strtod(item.c_str(), &end);
+        if (item.empty() || *end != '\0' || !(v >= 0.0))
+        {
+            return false;
+        }
+        values.push_back(v);
+    }
+
+    return !values.empty();
+}
+
+/**
+ * @brief Escribe una línea por punto con su etiqueta de cluster para cada consulta.
+ * @param out destino
+ * @param ps conjunto con el EMST calculado
+ * @param thresholds umbrales de distancia (--cut)
+ * @param counts números de clusters (--clusters)
+ */
+static void write_labels(output_writer &out, const point_set &ps,
+                         const vector<double> &thresholds, const vector<double> &counts)
+{
+    const dendrogram tree = ps.get_dendrogram();
 
-    // Imprimimos cada punto con su índice y posición pos="x,y!"
-    for (size_t i = 0; i < ps.size(); ++i)
+    // Una columna por consulta; la cabecera indica cuántos clusters salen en cada una
+    vector<vector<int>> columns;
+    out.put('#');
+
+    for (double t : thresholds)
     {
-        const CyA::point &p = ps[i];
+        columns.emplace_back();
+        const size_t k = tree.cut_threshold(t, columns.back());
+        out.put(" t=");
+        out.put_general(t);
+        out.put(':');
+        out.put(static_cast<unsigned long long>(k));
+    }
 
-        // Ejemplo: 0 [pos = "68,-21!"]
-        ofs << " " << i << " [pos = \"" << p.first << "," << p.second << "!\"]" << endl;
+    for (double c : counts)
+    {
+        columns.emplace_back();
+        const size_t k = tree.cut_clusters(static_cast<size_t>(c), columns.back());
+        out.put(" k=");
+        out.put(static_cast<unsigned long long>(c));
+        out.put(':');
+        out.put(static_cast<unsigned long long>(k));
     }
 
-    ofs << endl;
+    out.put('\n');
 
-    // Función auxiliar para encontrar el índice (posición) de un punto en el vector ps
-    // Para cada arco del árbol escribimos indices de nodos
-    // Necesitamos buscar el índice de cada punto en ps
-    auto find_index = [&](const CyA::point &p) -> int {
-        for (size_t k = 0; k < ps.size(); ++k)
+    for (size_t p = 0; p < ps.size(); ++p)
+    {
+        for (size_t q = 0; q < columns.size(); ++q)
         {
-            if (ps[k] == p)
+            if (q > 0)
             {
-                return static_cast<int>(k);
+                out.put(' ');
             }
+            out.put(static_cast<unsigned long long>(columns[q][p]));
         }
-        return -1;
-    };
+        out.put('\n');
+    }
+}
 
-    // Para cada arco del EMST escribir la conexión i -- j
-    for (const CyA::arc &a : tree)
-    {
-        int i = find_index(a.first);
-        int j = find_index(a.second);
+/**
+ * @brief Lee la entrada completa sin analizarla.
+ * @param fd descriptor abierto para lectura
+ * @param text contenido leído (salida)
+ * @return false si falla la lectura
+ */
+static bool read_input(int fd, string &text)
+{
+    char chunk[1 << 16];
 
-        // Si ambos índices válidos, escribir la arista en el DOT
-        if (i >= 0 && j >= 0)
+    for (;;)
+    {
+        const ssize_t r = read(fd, chunk, sizeof(chunk));
+        if (r < 0 && errno == EINTR)
         {
-            ofs << " " << i << " -- " << j << endl;
+            continue;
+        }
+        if (r <= 0)
+        {
+            return r == 0;
         }
-    }
 
-    ofs << "}" << endl;
+        text.append(chunk, static_cast<size_t>(r));
+    }
+}
 
-    ofs.close();
+/**
+ * @brief Imprime la línea de uso del programa.
+ * @param os flujo de salida
+ * @param program nombre del ejecutable
+ */
+static void usage(ostream &os, const char *program)
+{
+    os << "Uso: " << program << " [-d fichero.dot] [-a kruskal|delaunay|boruvka|filter|prim] [-j hilos]"
+       << " [-i fichero] [-c fichero.bin] [--online] [-b] [--stats]"
+       << " [--dim D] [--metric euclidean|squared|manhattan] [--float] [--check-float]"
+       << " [--external MiB] [--tmpdir dir] [--approx eps]"
+       << " [--cut t,...] [--clusters k,...] [--cache dir] [--cache-size MiB]"
+       << " [--serve socket] [--client socket] [--tiles franjas]" << endl;
 }
 
 int main(int argc, char *argv[])
 {
-    // Parseo simple de argumentos: -d fichero.dot
+    // Parseo simple de argumentos: -d fichero.dot, -a motor, -j hilos, -i fichero, -c fichero.bin, --online, -b, --stats,
+    // --dim D, --metric nombre, --float, --check-float, --external MiB, --tmpdir dir,
+    // --approx eps, --cut t,..., --clusters k,..., --cache dir, --cache-size MiB, --serve socket, --client socket,
+    // --tiles franjas, --tile-worker (interno: trabajador de --tiles)
     string dot_file;
+    string input_file;
+    string binary_file;
+    bool online = false;
+    bool batch = false;
+    bool stats = false;
+    kd_options kd;
+    bool check_float = false;
+    size_t external_budget = 0;
+    double approx = 0.0;
+    vector<double> cut_thresholds;
+    vector<double> cut_counts;
+    int tiles = 0;
+    bool tile_worker = false;
+    string serve_socket;
+    string client_socket;
+    string cache_dir;
+    uint64_t cache_size = static_cast<uint64_t>(RESULT_CACHE_DEFAULT_MIB) << 20;
+    string temp_dir = getenv("TMPDIR") != nullptr ? getenv("TMPDIR") : "/tmp";
+    engine algorithm = engine::kruskal;
+    int threads = 1;
     for (int i = 1; i < argc; ++i)
     {
         string arg(argv[i]);
@@ -98,39 +257,515 @@ int main(int argc, char *argv[])
         {
             dot_file = argv[++i];
         }
+        else if (arg == "-a" && i + 1 < argc)
+        {
+            if (!parse_engine(argv[++i], algorithm))
+            {
+                cerr << "Motor desconocido: " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else if (arg == "-i" && i + 1 < argc)
+        {
+            input_file = argv[++i];
+        }
+        else if (arg == "-c" && i + 1 < argc)
+        {
+            binary_file = argv[++i];
+        }
+        else if (arg == "-j" && i + 1 < argc)
+        {
+            threads = atoi(argv[++i]);
+            if (threads < 1)
+            {
+                cerr << "Número de hilos no válido: " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--online")
+        {
+            online = true;
+        }
+        else if (arg == "-b")
+        {
+            batch = true;
+        }
+        else if (arg == "--stats")
+        {
+            stats = true;
+        }
+        else if (arg == "--dim" && i + 1 < argc)
+        {
+            kd.dim = atoi(argv[++i]);
+            if (kd.dim < 1 || kd.dim > KD_MAX_DIM)
+            {
+                cerr << "Dimensión no válida: " << argv[i] << " (1.." << KD_MAX_DIM << ")" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--metric" && i + 1 < argc)
+        {
+            if (!parse_metric(argv[++i], kd.metric))
+            {
+                cerr << "Métrica desconocida: " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--float")
+        {
+            kd.single = true;
+        }
+        else if (arg == "--check-float")
+        {
+            check_float = true;
+        }
+        else if (arg == "--external" && i + 1 < argc)
+        {
+            const long long mib = atoll(argv[++i]);
+            if (mib < 1)
+            {
+                cerr << "Presupuesto de memoria no válido: " << argv[i] << endl;
+                return 1;
+            }
+            external_budget = static_cast<size_t>(mib) << 20;
+        }
+        else if (arg == "--tmpdir" && i + 1 < argc)
+        {
+            temp_dir = argv[++i];
+        }
+        else if ((arg == "--cut" || arg == "--clusters") && i + 1 < argc)
+        {
+            vector<double> &values = (arg == "--cut") ? cut_thresholds : cut_counts;
+            if (!parse_list(argv[++i], values))
+            {
+                cerr << "Lista no válida: " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--approx" && i + 1 < argc)
+        {
+            approx = atof(argv[++i]);
+            if (!(approx > 0.0))
+            {
+                cerr << "Error relativo no válido: " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--cache" && i + 1 < argc)
+        {
+            cache_dir = argv[++i];
+        }
+        else if (arg == "--cache-size" && i + 1 < argc)
+        {
+            const long long mib = atoll(argv[++i]);
+            if (mib < 1)
+            {
+                cerr << "Tamaño de caché no válido: " << argv[i] << endl;
+                return 1;
+            }
+            cache_size = static_cast<uint64_t>(mib) << 20;
+        }
+        else if (arg == "--serve" && i + 1 < argc)
+        {
+            serve_socket = argv[++i];
+        }
+        else if (arg == "--client" && i + 1 < argc)
+        {
+            client_socket = argv[++i];
+        }
+        else if (arg == "--tiles" && i + 1 < argc)
+        {
+            tiles = atoi(argv[++i]);
+            if (tiles < 1)
+            {
+                cerr << "Número de franjas no válido: " << argv[i] << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--tile-worker")
+        {
+            tile_worker = true;
+        }
         else if (arg == "-h" || arg == "--help")
         {
-            cout << "Uso: " << argv[0] << " [-d fichero.dot]" << endl;
+            usage(cout, argv[0]);
             return 0;
         }
         else
         {
             cerr << "Argumento desconocido: " << arg << endl;
-            cout << "Uso: " << argv[0] << " [-d fichero.dot]" << endl;
+            usage(cout, argv[0]);
             return 1;
         }
     }
 
-    // Leer puntos desde stdin
+    // Trabajador de --tiles: peticiones binarias por stdin, árboles por stdout
+    if (tile_worker)
+    {
+        return run_tile_worker(0, 1, algorithm) ? 0 : 1;
+    }
+
+    // Servidor residente: -a es el motor de todas las peticiones y -j el número de peticiones simultáneas
+    if (!serve_socket.empty())
+    {
+        string error;
+        if (!serve(serve_socket, algorithm, threads, error))
+        {
+            cerr << "ERROR: " << error << endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Cliente: reenvía la entrada sin analizarla (texto o binario) y escribe la respuesta
+    if (!client_socket.empty())
+    {
+        const int fd = input_file.empty() ? 0 : open(input_file.c_str(), O_RDONLY);
+        string request;
+        string response;
+        string error;
+
+        if (fd < 0 || !read_input(fd, request))
+        {
+            cerr << "ERROR: no se puede leer la entrada " << input_file << endl;
+            return 1;
+        }
+        if (fd != 0)
+        {
+            close(fd);
+        }
+
+        if (!send_request(client_socket, request, response, error))
+        {
+            cerr << "ERROR: " << error << endl;
+            return 1;
+        }
+
+        const bool failed = response.compare(0, strlen(SERVER_ERROR_PREFIX), SERVER_ERROR_PREFIX) == 0;
+
+        // Una respuesta completa termina con la línea del coste
+        const size_t last_line = response.rfind('\n', response.size() >= 2 ? response.size() - 2 : 0);
+        const bool complete = !response.empty() && response.back() == '\n' &&
+                              response.find("->", last_line == string::npos ? 0 : last_line) == string::npos;
+
+        if (!failed && !complete)
+        {
+            cerr << "ERROR: respuesta vacía o incompleta del servidor" << endl;
+            return 1;
+        }
+
+        (failed ? cerr : cout) << response << flush;
+        return failed ? 1 : 0;
+    }
+
+    // Otra dimensión, métrica o precisión: instancia kd_point_set<D, Metric, T>
+    // (sin DOT, lotes ni modo incremental)
+    if (kd.dim != 2 || kd.metric != metric_kind::euclidean || kd.single || check_float)
+    {
+        if (batch || online || !dot_file.empty() || !binary_file.empty())
+        {
+            cerr << "ERROR: --dim/--metric/--float no admiten -b, --online, -d ni -c." << endl;
+            return 1;
+        }
+
+        const int fd = input_file.empty() ? 0 : open(input_file.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            cerr << "ERROR: no se puede abrir " << input_file << endl;
+            return 1;
+        }
+
+        vector<double> coords;
+        string error;
+        const bool read_ok = read_coordinates(fd, kd.dim, coords, error);
+        if (fd != 0)
+        {
+            close(fd);
+        }
+
+        if (!read_ok)
+        {
+            cerr << "ERROR: lectura de puntos fallida: " << error << endl;
+            return 1;
+        }
+
+        kd.algorithm = algorithm;
+        kd.threads = threads;
+
+        // Comprobación de precisión: mismo árbol en double y en float, sin salida
+        if (check_float)
+        {
+            kd_options single = kd;
+            kd.single = false;
+            single.single = true;
+
+            double cost_double = 0.0;
+            double cost_single = 0.0;
+            if (!solve_kd(kd, coords, nullptr, cost_double, error) ||
+                !solve_kd(single, coords, nullptr, cost_single, error))
+            {
+                cerr << "ERROR: " << error << endl;
+                return 1;
+            }
+
+            double max_abs = 0.0;
+            for (double c : coords)
+            {
+                max_abs = max(max_abs, fabs(c));
+            }
+
+            const double difference = fabs(cost_single - cost_double);
+            const double tolerance = float_cost_tolerance(coords.size() / kd.dim, kd.dim, max_abs, cost_double);
+
+            cout << fixed << setprecision(6)
+                 << "double " << cost_double << " float " << cost_single
+                 << " diferencia " << difference << " tolerancia " << tolerance << endl;
+
+            return difference <= tolerance ? 0 : 1;
+        }
+
+        output_writer out(1);
+        double cost = 0.0;
+        if (!solve_kd(kd, coords, &out, cost, error))
+        {
+            cerr << "ERROR: " << error << endl;
+            return 1;
+        }
+
+        if (!out.flush())
+        {
+            cerr << "ERROR: no se pudo escribir la salida." << endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Modo por lotes: -j es el número de hilos del grupo, cada uno resuelve conjuntos enteros
+    if (batch)
+    {
+        vector<CyA::point_vector> sets;
+        string error;
+        emst_stats batch_stats;
+        batch_stats.engine = engine_name(algorithm);
+        batch_stats.threads = threads;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        if (!load_batch(input_file, sets, error))
+        {
+            cerr << "ERROR: lectura del lote fallida: " << error << endl;
+            return 1;
+        }
+        batch_stats.parse_seconds = seconds_since(start);
+
+        for (const CyA::point_vector &set : sets)
+        {
+            batch_stats.points += set.size();
+        }
+
+        // La salida se escribe a medida que terminan los conjuntos: cuenta como recorrido
+        start = chrono::steady_clock::now();
+        output_writer out(1);
+        solve_batch(sets, algorithm, threads, out);
+
+        if (!out.flush())
+        {
+            cerr << "ERROR: no se pudo escribir la salida." << endl;
+            return 1;
+        }
+        batch_stats.mst_seconds = seconds_since(start);
+
+        if (stats)
+        {
+            report_stats(batch_stats);
+        }
+
+        return 0;
+    }
+
+    // Leer puntos desde stdin (o desde el fichero de -i, de texto o binario)
     CyA::point_vector points;
-    if (!(cin >> points))
+    string error;
+    bool read_ok;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    if (!input_file.empty() && is_point_file(input_file))
+    {
+        // Formato binario: proyectar el fichero y copiar los puntos en bloque
+        mapped_point_file mapped;
+        read_ok = mapped.open(input_file, error);
+        if (read_ok)
+        {
+            mapped.read(points);
+        }
+    }
+    else
+    {
+        read_ok = input_file.empty() ? read_points(0, points, error)
+                                     : read_points(input_file, points, error);
+    }
+
+    if (!read_ok)
     {
-        cerr << "ERROR: lectura de puntos fallida." << endl;
+        cerr << "ERROR: lectura de puntos fallida: " << error << endl;
         return 1;
     }
 
-    // Construir point_set y calcular EMST
-    point_set ps(points);
-    ps.EMST();
+    const double parse_seconds = seconds_since(start);
+
+    // Conversión a formato binario: se escribe el fichero y no se calcula el EMST
+    if (!binary_file.empty())
+    {
+        if (!write_point_file(binary_file, points, error))
+        {
+            cerr << "ERROR: no se puede escribir el fichero binario: " << error << endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    // Construir point_set (sin copiar los puntos) y calcular EMST
+    point_set ps(online ? CyA::point_vector() : std::move(points));
+    ps.set_threads(threads);
+
+    start = chrono::steady_clock::now();
+
+    // Caché de resultados: la clave depende de los puntos y del motor que
+    // produciría el árbol (el modo incremental no se guarda)
+    result_cache cache(cache_dir, cache_size);
+    const bool use_cache = !cache_dir.empty() && !online;
+    uint64_t cache_key = 0;
+    string cache_options;
+    bool cache_hit = false;
+
+    if (use_cache)
+    {
+        ostringstream options;
+        if (approx > 0.0)
+        {
+            options << "approx " << setprecision(17) << approx;
+        }
+        else
+        {
+            options << (external_budget > 0 && tiles == 0 ? "external" : engine_name(algorithm));
+            if (tiles > 0)
+            {
+                options << " tiled " << tiles;
+            }
+        }
+
+        cache_options = options.str();
+        cache_key = result_cache::key(ps.get_points(), cache_options);
+
+        CyA::index_tree tree;
+        double cached_cost = 0.0;
+        cache_hit = cache.lookup(cache_key, ps.get_points(), cache_options, tree, cached_cost);
+        if (cache_hit)
+        {
+            ps.set_index_tree(std::move(tree));
+        }
+    }
+
+    if (cache_hit)
+    {
+        // Árbol leído de la caché: no se ejecuta ningún motor
+    }
+    else if (online)
+    {
+        // Modo incremental: los puntos se añaden uno a uno actualizando el árbol
+        for (const CyA::point &p : points)
+        {
+            ps.insert(p);
+        }
+    }
+    else if (approx > 0.0)
+    {
+        // Aproximado: ignora -a
+        ps.EMST_approx(approx);
+    }
+    else if (tiles > 0)
+    {
+        // Por franjas: -j es el número de procesos trabajadores y -a su motor
+        tile_workers workers;
+        const vector<string> command = {access("/proc/self/exe", X_OK) == 0 ? "/proc/self/exe" : argv[0],
+                                        "--tile-worker", "-a", engine_name(algorithm)};
+
+        if (!workers.start(command, threads, error) || !ps.EMST_tiled(tiles, workers, error))
+        {
+            cerr << "ERROR: EMST por franjas: " << error << endl;
+            return 1;
+        }
+    }
+    else if (external_budget > 0)
+    {
+        // Memoria acotada: tramos de aristas ordenados en disco (ignora -a)
+        if (!ps.EMST_external(external_budget, temp_dir, error))
+        {
+            cerr << "ERROR: Kruskal externo: " << error << endl;
+            return 1;
+        }
+    }
+    else
+    {
+        ps.EMST(algorithm);
+    }
+
+    if (use_cache && !cache_hit)
+    {
+        // Un fallo al guardar no impide escribir el resultado
+        if (!cache.store(cache_key, ps.get_points(), cache_options, ps.get_index_tree(), ps.get_cost(), error))
+        {
+            cerr << "AVISO: no se pudo guardar en la caché: " << error << endl;
+        }
+    }
+
+    const double solve_seconds = seconds_since(start);
+    start = chrono::steady_clock::now();
 
     // Si se solicitó, generar fichero DOT para visualización
     if (!dot_file.empty())
     {
-        generate_dot(dot_file, points, ps.get_tree());
+        generate_dot(dot_file, ps.get_points(), ps.get_output_tree());
+    }
+
+    // Escribimos el árbol y coste a stdout (sin pasar por iostream), o las
+    // etiquetas de cluster si se pidió algún corte del dendrograma
+    output_writer out(1);
+    if (!cut_thresholds.empty() || !cut_counts.empty())
+    {
+        write_labels(out, ps, cut_thresholds, cut_counts);
+    }
+    else
+    {
+        ps.write_tree(out);
+    }
+
+    if (!out.flush())
+    {
+        cerr << "ERROR: no se pudo escribir la salida." << endl;
+        return 1;
     }
 
-    // Escribimos el árbol y coste a stdout
-    ps.write_tree(cout);
+    if (stats)
+    {
+        // En modo incremental no se llama a EMST(): todo el tiempo es de recorrido
+        emst_stats run_stats = (online || cache_hit) ? emst_stats() : ps.get_stats();
+        run_stats.parse_seconds = parse_seconds;
+        run_stats.output_seconds = seconds_since(start);
+
+        if (online || cache_hit)
+        {
+            run_stats.engine = online ? "online" : "cache";
+            run_stats.points = ps.size();
+            run_stats.threads = threads;
+            run_stats.mst_seconds = solve_seconds;
+        }
+
+        report_stats(run_stats);
+    }
 
     return 0;
 }
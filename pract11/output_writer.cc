@@ -0,0 +1,231 @@
+/**
+ * @file output_writer.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de la escritura con búfer.
+ */
+
+#include "output_writer.h"
+
+#include <charconv>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace EMST
+{
+    /**
+     * @brief Constructor sobre un descriptor abierto.
+     * @param fd descriptor de salida
+     */
+    output_writer::output_writer(int fd) : fd_(fd),
+                                           target_(nullptr),
+                                           owns_fd_(false),
+                                           ok_(fd >= 0),
+                                           buffer_(OUTPUT_BUFFER_SIZE),
+                                           used_(0)
+    {
+    }
+
+    /**
+     * @brief Constructor: abre (o crea) el fichero para escritura.
+     * @param filename nombre del fichero
+     */
+    output_writer::output_writer(const std::string &filename) : fd_(::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+                                                                target_(nullptr),
+                                                                owns_fd_(true),
+                                                                ok_(fd_ >= 0),
+                                                                buffer_(OUTPUT_BUFFER_SIZE),
+                                                                used_(0)
+    {
+    }
+
+    /**
+     * @brief Constructor: escribe en la cadena target (búfer pequeño, se vuelca al añadir).
+     * @param target cadena destino
+     */
+    output_writer::output_writer(std::string &target) : fd_(-1),
+                                                        target_(&target),
+                                                        owns_fd_(false),
+                                                        ok_(true),
+                                                        buffer_(1 << 12),
+                                                        used_(0)
+    {
+    }
+
+    /**
+     * @brief Destructor: vuelca el búfer y cierra el fichero propio.
+     */
+    output_writer::~output_writer(void)
+    {
+        flush();
+
+        if (owns_fd_ && fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+    }
+
+    /**
+     * @brief Añade una cadena terminada en '\0'.
+     * @param s cadena
+     */
+    void output_writer::put(const char *s)
+    {
+        while (*s != '\0')
+        {
+            put(*s++);
+        }
+    }
+
+    /**
+     * @brief Añade un entero sin signo en decimal.
+     * @param value valor
+     */
+    void output_writer::put(unsigned long long value)
+    {
+        reserve(24);
+
+        char *first = buffer_.data() + used_;
+        const std::to_chars_result r = std::to_chars(first, first + 24, value);
+        used_ += static_cast<size_t>(r.ptr - first);
+    }
+
+    /**
+     * @brief Añade un double en notación fija con anchura mínima (relleno con espacios a la izquierda).
+     * @param value valor
+     * @param width anchura mínima
+     * @param precision número de decimales
+     */
+    void output_writer::put_fixed(double value, int width, int precision)
+    {
+        char tmp[400];
+        const std::to_chars_result r = std::to_chars(tmp, tmp + sizeof(tmp), value, std::chars_format::fixed, precision);
+        const int length = static_cast<int>(r.ptr - tmp);
+
+        for (int k = length; k < width; ++k)
+        {
+            put(' ');
+        }
+
+        reserve(static_cast<size_t>(length));
+        std::memcpy(buffer_.data() + used_, tmp, static_cast<size_t>(length));
+        used_ += static_cast<size_t>(length);
+    }
+
+    /**
+     * @brief Añade un double con el formato general de ostream (6 cifras significativas).
+     * @param value valor
+     */
+    void output_writer::put_general(double value)
+    {
+        reserve(32);
+
+        char *first = buffer_.data() + used_;
+        const std::to_chars_result r = std::to_chars(first, first + 32, value, std::chars_format::general, 6);
+        used_ += static_cast<size_t>(r.ptr - first);
+    }
+
+    /**
+     * @brief Escribe el contenido del búfer con write() (o lo añade a la cadena destino).
+     * @return false si hubo algún error
+     */
+    bool output_writer::flush(void)
+    {
+        if (target_ != nullptr)
+        {
+            target_->append(buffer_.data(), used_);
+            used_ = 0;
+            return true;
+        }
+
+        size_t done = 0;
+
+        while (ok_ && done < used_)
+        {
+            const ssize_t w = ::write(fd_, buffer_.data() + done, used_ - done);
+
+            if (w < 0)
+            {
+                if (errno != EINTR)
+                {
+                    ok_ = false;
+                }
+                continue;
+            }
+
+            done += static_cast<size_t>(w);
+        }
+
+        used_ = 0;
+        return ok_;
+    }
+
+    /**
+     * @brief Escribe cada arco como "(x1, y1) -> (x2, y2)" y el coste con 2 decimales.
+     * @param out destino
+     * @param points puntos del conjunto
+     * @param tree arcos del árbol
+     * @param cost coste total
+     */
+    void write_tree(output_writer &out, const CyA::point_vector &points, const CyA::index_tree &tree, double cost)
+    {
+        for (const CyA::index_arc &a : tree)
+        {
+            const CyA::point &p = points[a.first];
+            const CyA::point &q = points[a.second];
+
+            out.put('(');
+            out.put_fixed(p.first, MAX_SZ, MAX_PREC);
+            out.put(", ");
+            out.put_fixed(p.second, MAX_SZ, MAX_PREC);
+            out.put(") -> (");
+            out.put_fixed(q.first, MAX_SZ, MAX_PREC);
+            out.put(", ");
+            out.put_fixed(q.second, MAX_SZ, MAX_PREC);
+            out.put(")\n");
+        }
+
+        out.put_fixed(cost, 0, 2);
+        out.put('\n');
+    }
+
+    /**
+     * @brief Escribe el grafo DOT con un nodo por punto y una arista por arco del árbol.
+     * @param out destino
+     * @param points puntos del conjunto
+     * @param tree arcos del árbol
+     */
+    void write_dot(output_writer &out, const CyA::point_vector &points, const CyA::index_tree &tree)
+    {
+        // Cabecera del grafo
+        out.put("graph{ \n\n");
+
+        // Ejemplo: 0 [pos = "68,-21!"]
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            out.put(' ');
+            out.put(static_cast<unsigned long long>(i));
+            out.put(" [pos = \"");
+            out.put_general(points[i].first);
+            out.put(',');
+            out.put_general(points[i].second);
+            out.put("!\"]\n");
+        }
+
+        out.put('\n');
+
+        // Conexiones i -- j directamente desde los índices del árbol
+        for (const CyA::index_arc &a : tree)
+        {
+            out.put(' ');
+            out.put(static_cast<unsigned long long>(a.first));
+            out.put(" -- ");
+            out.put(static_cast<unsigned long long>(a.second));
+            out.put('\n');
+        }
+
+        out.put("}\n");
+    }
+}
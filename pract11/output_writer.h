@@ -0,0 +1,144 @@
+/**
+ * @file output_writer.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Escritura con búfer, sin iostream, de la lista de arcos del EMST y del fichero DOT.
+ *
+ * Los números se formatean con std::to_chars directamente en un búfer grande
+ * que se vuelca al descriptor con write() solo cuando se llena o al terminar.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "point_types.h"
+
+// Tamaño del búfer de salida (1 MiB)
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+
+namespace EMST
+{
+    /**
+     * @class output_writer
+     * @brief Búfer de salida sobre un descriptor de fichero.
+     */
+    class output_writer
+    {
+    private:
+        int fd_;
+        std::string *target_;
+        bool owns_fd_;
+        bool ok_;
+        std::vector<char> buffer_;
+        size_t used_;
+
+    public:
+        /**
+         * @brief Escribe sobre un descriptor ya abierto (no se cierra al terminar).
+         * @param fd descriptor de salida (1 para stdout)
+         */
+        explicit output_writer(int fd);
+
+        /**
+         * @brief Crea (o trunca) el fichero indicado y escribe sobre él.
+         * @param filename nombre del fichero
+         */
+        explicit output_writer(const std::string &filename);
+
+        /**
+         * @brief Escribe en memoria, añadiendo al final de target en cada volcado.
+         * @param target cadena destino
+         */
+        explicit output_writer(std::string &target);
+
+        /**
+         * @brief Destructor: vuelca lo pendiente y cierra el fichero si es propio.
+         */
+        ~output_writer(void);
+
+        output_writer(const output_writer &) = delete;
+        output_writer &operator=(const output_writer &) = delete;
+
+        /**
+         * @brief Añade un carácter.
+         * @param c carácter
+         */
+        inline void put(char c)
+        {
+            if (used_ == buffer_.size())
+            {
+                flush();
+            }
+            buffer_[used_++] = c;
+        }
+
+        /**
+         * @brief Añade una cadena.
+         * @param s cadena terminada en '\0'
+         */
+        void put(const char *s);
+
+        /**
+         * @brief Añade un entero sin signo.
+         * @param value valor
+         */
+        void put(unsigned long long value);
+
+        /**
+         * @brief Añade un double en notación fija, alineado a la derecha (como setw + fixed + setprecision).
+         * @param value valor
+         * @param width anchura mínima
+         * @param precision número de decimales
+         */
+        void put_fixed(double value, int width, int precision);
+
+        /**
+         * @brief Añade un double con el formato por defecto de ostream (%g, 6 cifras).
+         * @param value valor
+         */
+        void put_general(double value);
+
+        /**
+         * @brief Vuelca el búfer al descriptor (o a la cadena destino).
+         * @return false si se produjo algún error de escritura
+         */
+        bool flush(void);
+
+        /**
+         * @brief Indica si todas las escrituras (y la apertura) han ido bien.
+         * @return true si no ha habido errores
+         */
+        inline bool good(void) const { return ok_; }
+
+    private:
+        /**
+         * @brief Garantiza que caben n bytes más en el búfer.
+         * @param n número de bytes
+         */
+        inline void reserve(size_t n)
+        {
+            if (buffer_.size() - used_ < n)
+            {
+                flush();
+            }
+        }
+    };
+
+    /**
+     * @brief Escribe el EMST en formato "(x1, y1) -> (x2, y2)" y una línea final con el coste.
+     * @param out destino
+     * @param points puntos del conjunto
+     * @param tree arcos del árbol como pares de índices
+     * @param cost coste total del árbol
+     */
+    void write_tree(output_writer &out, const CyA::point_vector &points, const CyA::index_tree &tree, double cost);
+
+    /**
+     * @brief Escribe el grafo DOT (nodos con posición y arcos i -- j) usando directamente los índices.
+     * @param out destino
+     * @param points puntos del conjunto
+     * @param tree arcos del árbol como pares de índices
+     */
+    void write_dot(output_writer &out, const CyA::point_vector &points, const CyA::index_tree &tree);
+}
@@ -0,0 +1,128 @@
+/**
+ * @file parallel_sort.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de la ordenación paralela de aristas.
+ */
+
+#include "parallel_sort.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace EMST
+{
+    namespace
+    {
+        /**
+         * @brief Ordena por bloques en paralelo y mezcla los bloques por parejas.
+         * @param av vector de aristas a ordenar
+         * @param threads número de hilos
+         * @param less orden total de las aristas
+         */
+        template <class Arc, class Less>
+        void sort_blocks(std::vector<Arc> &av, int threads, const Less &less)
+        {
+            const size_t n = av.size();
+
+            // No compensa lanzar hilos para vectores pequeños
+            if (threads <= 1 || n < 2 * static_cast<size_t>(threads) * 1024)
+            {
+                std::sort(av.begin(), av.end(), less);
+                return;
+            }
+
+            // Límites de los bloques: bounds[k] .. bounds[k + 1]
+            std::vector<size_t> bounds(threads + 1);
+            for (int k = 0; k <= threads; ++k)
+            {
+                bounds[k] = n * k / threads;
+            }
+
+            // Fase 1: cada hilo ordena su bloque
+            std::vector<std::thread> workers;
+            workers.reserve(threads);
+
+            for (int k = 0; k < threads; ++k)
+            {
+                workers.emplace_back([&av, &bounds, &less, k]() {
+                    std::sort(av.begin() + bounds[k], av.begin() + bounds[k + 1], less);
+                });
+            }
+
+            for (std::thread &t : workers)
+            {
+                t.join();
+            }
+
+            // Fase 2: mezclar bloques vecinos, duplicando el tamaño en cada ronda
+            while (bounds.size() > 2)
+            {
+                std::vector<size_t> merged;
+                merged.reserve(bounds.size() / 2 + 2);
+
+                workers.clear();
+
+                size_t k = 0;
+                for (; k + 2 < bounds.size(); k += 2)
+                {
+                    const size_t first = bounds[k];
+                    const size_t middle = bounds[k + 1];
+                    const size_t last = bounds[k + 2];
+
+                    workers.emplace_back([&av, &less, first, middle, last]() {
+                        std::inplace_merge(av.begin() + first, av.begin() + middle, av.begin() + last, less);
+                    });
+
+                    merged.push_back(first);
+                }
+
+                // Un bloque sin pareja pasa tal cual a la siguiente ronda
+                if (k + 1 < bounds.size())
+                {
+                    merged.push_back(bounds[k]);
+                }
+                merged.push_back(n);
+
+                for (std::thread &t : workers)
+                {
+                    t.join();
+                }
+
+                bounds.swap(merged);
+            }
+        }
+    }
+
+    /**
+     * @brief Ordena aristas con peso double.
+     * @param av vector de aristas a ordenar
+     * @param threads número de hilos
+     */
+    void parallel_sort(CyA::index_arc_vector &av, int threads)
+    {
+        sort_blocks(av, threads, std::less<CyA::weighted_index_arc>());
+    }
+
+    /**
+     * @brief Ordena aristas con peso float.
+     * @param av vector de aristas a ordenar
+     * @param threads número de hilos
+     */
+    void parallel_sort(CyA::index_arc_vector_f &av, int threads)
+    {
+        sort_blocks(av, threads, std::less<CyA::weighted_index_arc_f>());
+    }
+
+    /**
+     * @brief Ordena aristas con peso double según order.
+     * @param av vector de aristas a ordenar
+     * @param threads número de hilos
+     * @param order orden de las aristas
+     */
+    void parallel_sort(CyA::index_arc_vector &av, int threads, const CyA::arc_order &order)
+    {
+        sort_blocks(av, threads, order);
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file parallel_sort.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Ordenación paralela de vectores de aristas (ordenación por bloques + mezcla).
+ */
+
+#pragma once
+
+#include "point_types.h"
+
+namespace EMST
+{
+    /**
+     * @brief Ordena av con el orden (peso, i, j) usando varios hilos.
+     *
+     * Cada hilo ordena un bloque contiguo y después los bloques se mezclan por
+     * parejas, también en paralelo. Como el orden es total el resultado es
+     * idéntico al de std::sort.
+     * @param av vector de aristas a ordenar
+     * @param threads número de hilos (1 equivale a std::sort)
+     */
+    void parallel_sort(CyA::index_arc_vector &av, int threads);
+
+    /**
+     * @brief Igual que parallel_sort para aristas con peso float.
+     * @param av vector de aristas a ordenar
+     * @param threads número de hilos
+     */
+    void parallel_sort(CyA::index_arc_vector_f &av, int threads);
+
+    /**
+     * @brief Igual que parallel_sort con el orden de la versión original (ver arc_order).
+     * @param av vector de aristas a ordenar
+     * @param threads número de hilos
+     * @param order orden de las aristas
+     */
+    void parallel_sort(CyA::index_arc_vector &av, int threads, const CyA::arc_order &order);
+}
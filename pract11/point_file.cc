@@ -0,0 +1,314 @@
+/**
+ * @file point_file.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación del formato binario de puntos.
+ */
+
+#include "point_file.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace EMST
+{
+    static_assert(sizeof(point_file_header) == 32, "la cabecera debe ocupar 32 bytes");
+    static_assert(sizeof(CyA::point) == 2 * sizeof(double), "CyA::point debe ser dos double empaquetados");
+
+    namespace
+    {
+        /**
+         * @brief Comprueba firma, versión, dimensión, tipo y que caben los puntos indicados.
+         * @param data inicio de los datos (cabecera incluida)
+         * @param length longitud en bytes
+         * @param error motivo del rechazo (salida)
+         * @return cabecera válida o nullptr
+         */
+        const point_file_header *check_header(const void *data, size_t length, std::string &error)
+        {
+            if (length < sizeof(point_file_header))
+            {
+                error = "fichero binario demasiado corto";
+                return nullptr;
+            }
+
+            const point_file_header *h = static_cast<const point_file_header *>(data);
+
+            if (std::memcmp(h->magic, POINT_FILE_MAGIC, sizeof(POINT_FILE_MAGIC)) != 0 ||
+                h->version != POINT_FILE_VERSION)
+            {
+                error = "no es un fichero binario de puntos";
+                return nullptr;
+            }
+
+            if (h->dimension != 2 || (h->type != coord_type::float64 && h->type != coord_type::float32))
+            {
+                error = "dimensión o tipo de coordenada no soportados";
+                return nullptr;
+            }
+
+            const size_t coord_size = h->type == coord_type::float64 ? sizeof(double) : sizeof(float);
+            if ((length - sizeof(point_file_header)) / (2 * coord_size) < h->count)
+            {
+                error = "el fichero tiene menos puntos de los indicados en la cabecera";
+                return nullptr;
+            }
+
+            return h;
+        }
+
+        /**
+         * @brief Copia los puntos que siguen a una cabecera válida.
+         * @param h cabecera (seguida de las coordenadas)
+         * @param ps vector a rellenar
+         */
+        void copy_points(const point_file_header *h, CyA::point_vector &ps)
+        {
+            const char *payload = reinterpret_cast<const char *>(h) + sizeof(point_file_header);
+            const size_t n = static_cast<size_t>(h->count);
+
+            if (h->type == coord_type::float64)
+            {
+                // Las coordenadas ya tienen la disposición de CyA::point: copia en bloque
+                const CyA::point *first = reinterpret_cast<const CyA::point *>(payload);
+                ps.assign(first, first + n);
+                return;
+            }
+
+            const float *coords = reinterpret_cast<const float *>(payload);
+            ps.resize(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                ps[i] = std::make_pair(static_cast<double>(coords[2 * i]), static_cast<double>(coords[2 * i + 1]));
+            }
+        }
+    }
+
+    /**
+     * @brief Constructor: fichero sin abrir.
+     */
+    mapped_point_file::mapped_point_file(void) : data_(nullptr),
+                                                 length_(0),
+                                                 header_(nullptr)
+    {
+    }
+
+    /**
+     * @brief Destructor: libera la proyección.
+     */
+    mapped_point_file::~mapped_point_file(void)
+    {
+        close();
+    }
+
+    /**
+     * @brief Proyecta el fichero en memoria y comprueba cabecera y tamaño.
+     * @param filename nombre del fichero
+     * @param error mensaje de error (salida)
+     * @return true si el fichero es válido
+     */
+    bool mapped_point_file::open(const std::string &filename, std::string &error)
+    {
+        close();
+
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            error = filename + ": " + std::strerror(errno);
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            error = filename + ": fichero binario demasiado corto";
+            ::close(fd);
+            return false;
+        }
+
+        length_ = static_cast<size_t>(st.st_size);
+        data_ = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (data_ == MAP_FAILED)
+        {
+            data_ = nullptr;
+            error = filename + ": " + std::strerror(errno);
+            return false;
+        }
+
+        const point_file_header *h = check_header(data_, length_, error);
+
+        if (h == nullptr)
+        {
+            error = filename + ": " + error;
+            close();
+            return false;
+        }
+
+        header_ = h;
+        return true;
+    }
+
+    /**
+     * @brief Libera la proyección.
+     */
+    void mapped_point_file::close(void)
+    {
+        if (data_ != nullptr)
+        {
+            munmap(data_, length_);
+        }
+
+        data_ = nullptr;
+        length_ = 0;
+        header_ = nullptr;
+    }
+
+    /**
+     * @brief Copia los puntos proyectados al vector.
+     * @param ps vector a rellenar
+     */
+    void mapped_point_file::read(CyA::point_vector &ps) const
+    {
+        ps.clear();
+
+        if (header_ == nullptr)
+        {
+            return;
+        }
+
+        copy_points(header_, ps);
+    }
+
+    /**
+     * @brief Valida y copia un fichero binario ya cargado en memoria.
+     * @param begin inicio de los datos
+     * @param end fin de los datos
+     * @param ps vector a rellenar
+     * @param error mensaje de error (salida)
+     * @return true si los datos son un fichero binario válido
+     */
+    bool decode_point_file(const char *begin, const char *end, CyA::point_vector &ps, std::string &error)
+    {
+        // Copia de la cabecera: el búfer puede no estar alineado
+        point_file_header aligned;
+        const size_t length = static_cast<size_t>(end - begin);
+
+        if (length < sizeof(aligned))
+        {
+            error = "fichero binario demasiado corto";
+            return false;
+        }
+
+        std::memcpy(&aligned, begin, sizeof(aligned));
+        const point_file_header *h = check_header(&aligned, length, error);
+
+        if (h == nullptr)
+        {
+            return false;
+        }
+
+        const char *payload = begin + sizeof(point_file_header);
+        const size_t n = static_cast<size_t>(h->count);
+
+        ps.resize(n);
+        if (h->type == coord_type::float64)
+        {
+            std::memcpy(static_cast<void *>(ps.data()), payload, n * sizeof(CyA::point));
+            return true;
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            float xy[2];
+            std::memcpy(xy, payload + i * sizeof(xy), sizeof(xy));
+            ps[i] = std::make_pair(static_cast<double>(xy[0]), static_cast<double>(xy[1]));
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Comprueba la firma de los primeros bytes del fichero.
+     * @param filename nombre del fichero
+     * @return true si coincide con POINT_FILE_MAGIC
+     */
+    bool is_point_file(const std::string &filename)
+    {
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        char magic[sizeof(POINT_FILE_MAGIC)];
+        const ssize_t r = ::read(fd, magic, sizeof(magic));
+        ::close(fd);
+
+        return r == static_cast<ssize_t>(sizeof(magic)) && std::memcmp(magic, POINT_FILE_MAGIC, sizeof(magic)) == 0;
+    }
+
+    /**
+     * @brief Escribe cabecera y coordenadas double empaquetadas.
+     * @param filename nombre del fichero a crear
+     * @param ps vector de puntos
+     * @param error mensaje de error (salida)
+     * @return true si la escritura fue correcta
+     */
+    bool write_point_file(const std::string &filename, const CyA::point_vector &ps, std::string &error)
+    {
+        point_file_header h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, POINT_FILE_MAGIC, sizeof(POINT_FILE_MAGIC));
+        h.version = POINT_FILE_VERSION;
+        h.dimension = 2;
+        h.type = coord_type::float64;
+        h.reserved = 0;
+        h.count = ps.size();
+
+        const int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            error = filename + ": " + std::strerror(errno);
+            return false;
+        }
+
+        // Escribir cabecera y puntos tal cual están en memoria
+        const char *chunks[2] = {reinterpret_cast<const char *>(&h), reinterpret_cast<const char *>(ps.data())};
+        const size_t lengths[2] = {sizeof(h), ps.size() * sizeof(CyA::point)};
+
+        for (int c = 0; c < 2; ++c)
+        {
+            size_t done = 0;
+            while (done < lengths[c])
+            {
+                const ssize_t w = ::write(fd, chunks[c] + done, lengths[c] - done);
+                if (w < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    error = filename + ": " + std::strerror(errno);
+                    ::close(fd);
+                    return false;
+                }
+                done += static_cast<size_t>(w);
+            }
+        }
+
+        if (::close(fd) != 0)
+        {
+            error = filename + ": " + std::strerror(errno);
+            return false;
+        }
+
+        return true;
+    }
+}
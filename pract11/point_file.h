@@ -0,0 +1,132 @@
+/**
+ * @file point_file.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Formato binario de puntos y su proyección en memoria.
+ *
+ * Un fichero binario consta de una cabecera de 32 bytes (firma, versión,
+ * dimensión, tipo de coordenada y número de puntos) seguida de las
+ * coordenadas empaquetadas x0 y0 x1 y1 ... en el orden de bytes de la máquina.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "point_types.h"
+
+#define POINT_FILE_MAGIC "EMSTPTS"
+#define POINT_FILE_VERSION 1
+
+namespace EMST
+{
+    /**
+     * @brief Tipo de las coordenadas almacenadas en el fichero binario.
+     */
+    enum class coord_type : std::uint32_t
+    {
+        float64 = 0, ///< double (8 bytes)
+        float32 = 1  ///< float (4 bytes)
+    };
+
+    /**
+     * @brief Cabecera del fichero binario de puntos (32 bytes).
+     */
+    struct point_file_header
+    {
+        char magic[8];          ///< "EMSTPTS\0"
+        std::uint32_t version;  ///< POINT_FILE_VERSION
+        std::uint32_t dimension; ///< número de coordenadas por punto (2)
+        coord_type type;        ///< tipo de cada coordenada
+        std::uint32_t reserved; ///< 0
+        std::uint64_t count;    ///< número de puntos
+    };
+
+    /**
+     * @class mapped_point_file
+     * @brief Fichero binario de puntos proyectado en memoria (solo lectura).
+     *
+     * Con coordenadas double las páginas proyectadas ya tienen la disposición de
+     * un vector de CyA::point, así que cargarlas es una copia en bloque sin
+     * ningún análisis de texto.
+     */
+    class mapped_point_file
+    {
+    private:
+        void *data_;
+        size_t length_;
+        const point_file_header *header_;
+
+    public:
+        /**
+         * @brief Constructor: fichero sin abrir.
+         */
+        mapped_point_file(void);
+
+        /**
+         * @brief Destructor: libera la proyección.
+         */
+        ~mapped_point_file(void);
+
+        mapped_point_file(const mapped_point_file &) = delete;
+        mapped_point_file &operator=(const mapped_point_file &) = delete;
+
+        /**
+         * @brief Proyecta el fichero y valida su cabecera.
+         * @param filename nombre del fichero
+         * @param error mensaje de error (salida)
+         * @return true si el fichero es un fichero binario de puntos válido
+         */
+        bool open(const std::string &filename, std::string &error);
+
+        /**
+         * @brief Libera la proyección (si la hay).
+         */
+        void close(void);
+
+        /**
+         * @brief Copia los puntos al vector (copia en bloque si son double).
+         * @param ps vector a rellenar
+         */
+        void read(CyA::point_vector &ps) const;
+
+        /**
+         * @brief Número de puntos del fichero.
+         * @return número de puntos
+         */
+        inline size_t size(void) const { return header_ ? static_cast<size_t>(header_->count) : 0; }
+
+        /**
+         * @brief Cabecera del fichero proyectado.
+         * @return puntero a la cabecera (nullptr si no está abierto)
+         */
+        inline const point_file_header *header(void) const { return header_; }
+    };
+
+    /**
+     * @brief Indica si el fichero empieza por la firma del formato binario.
+     * @param filename nombre del fichero
+     * @return true si es un fichero binario de puntos
+     */
+    bool is_point_file(const std::string &filename);
+
+    /**
+     * @brief Convierte un fichero binario recibido en memoria (p. ej. por un socket).
+     * @param begin inicio de los datos (cabecera incluida, sin requisitos de alineación)
+     * @param end fin de los datos
+     * @param ps vector a rellenar
+     * @param error mensaje de error (salida)
+     * @return true si los datos son un fichero binario válido
+     */
+    bool decode_point_file(const char *begin, const char *end, CyA::point_vector &ps, std::string &error);
+
+    /**
+     * @brief Escribe el vector de puntos en formato binario (coordenadas double).
+     * @param filename nombre del fichero a crear
+     * @param ps vector de puntos
+     * @param error mensaje de error (salida)
+     * @return true si la escritura fue correcta
+     */
+    bool write_point_file(const std::string &filename, const CyA::point_vector &ps, std::string &error);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file point_generator.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de los generadores de puntos sintéticos.
+ */
+
+#include "point_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace EMST
+{
+    /**
+     * @brief Convierte un nombre en una distribución.
+     * @param name nombre
+     * @param d distribución (salida)
+     * @return true si el nombre es válido
+     */
+    bool parse_distribution(const std::string &name, distribution &d)
+    {
+        if (name == "uniform")
+        {
+            d = distribution::uniform;
+        }
+        else if (name == "clustered")
+        {
+            d = distribution::clustered;
+        }
+        else if (name == "grid")
+        {
+            d = distribution::grid;
+        }
+        else if (name == "collinear")
+        {
+            d = distribution::collinear;
+        }
+        else if (name == "duplicate")
+        {
+            d = distribution::duplicate;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Nombre de una distribución.
+     * @param d distribución
+     * @return nombre
+     */
+    const char *distribution_name(distribution d)
+    {
+        switch (d)
+        {
+        case distribution::uniform:
+            return "uniform";
+        case distribution::clustered:
+            return "clustered";
+        case distribution::grid:
+            return "grid";
+        case distribution::collinear:
+            return "collinear";
+        case distribution::duplicate:
+            return "duplicate";
+        }
+
+        return "";
+    }
+
+    /**
+     * @brief Genera n puntos de la distribución d.
+     * @param d distribución
+     * @param n número de puntos
+     * @param seed semilla
+     * @param ps vector a rellenar
+     */
+    void generate_points(distribution d, std::size_t n, std::uint64_t seed, CyA::point_vector &ps)
+    {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> coord(0.0, 1000.0);
+
+        ps.clear();
+        ps.reserve(n);
+
+        switch (d)
+        {
+        case distribution::uniform:
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const double x = coord(rng);
+                ps.emplace_back(x, coord(rng));
+            }
+            break;
+
+        case distribution::clustered:
+        {
+            // √n centros uniformes y una nube gaussiana estrecha alrededor de cada uno
+            const std::size_t centers = std::max<std::size_t>(1, static_cast<std::size_t>(std::sqrt(static_cast<double>(n))));
+            CyA::point_vector center(centers);
+            for (CyA::point &c : center)
+            {
+                const double x = coord(rng);
+                c = CyA::point(x, coord(rng));
+            }
+
+            std::uniform_int_distribution<std::size_t> pick(0, centers - 1);
+            std::normal_distribution<double> spread(0.0, 5.0);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const CyA::point &c = center[pick(rng)];
+                const double x = c.first + spread(rng);
+                ps.emplace_back(x, c.second + spread(rng));
+            }
+            break;
+        }
+
+        case distribution::grid:
+        {
+            const std::size_t side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                ps.emplace_back(static_cast<double>(k % side), static_cast<double>(k / side));
+            }
+            break;
+        }
+
+        case distribution::collinear:
+            // Recta y = 2x + 1 recorrida en orden aleatorio
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const double x = coord(rng);
+                ps.emplace_back(x, 2.0 * x + 1.0);
+            }
+            break;
+
+        case distribution::duplicate:
+        {
+            // Unas √n posiciones enteras distintas, cada una repetida ~√n veces
+            const std::size_t distinct = std::max<std::size_t>(1, static_cast<std::size_t>(std::sqrt(static_cast<double>(n))));
+            std::uniform_int_distribution<int> cell(0, 999);
+            CyA::point_vector base(distinct);
+            for (CyA::point &b : base)
+            {
+                const double x = cell(rng);
+                b = CyA::point(x, cell(rng));
+            }
+
+            std::uniform_int_distribution<std::size_t> pick(0, distinct - 1);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                ps.push_back(base[pick(rng)]);
+            }
+            break;
+        }
+        }
+    }
+}
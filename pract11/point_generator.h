@@ -0,0 +1,55 @@
+/**
+ * @file point_generator.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Generadores de conjuntos de puntos sintéticos para las pruebas de rendimiento.
+ *
+ * Cada distribución ejercita un caso distinto de los motores: uniforme (caso
+ * medio), agrupada (muchas aristas cortas y pocas largas), rejilla (empates de
+ * pesos), colineal (triangulación degenerada) y con duplicados (aristas de peso 0).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "point_types.h"
+
+namespace EMST
+{
+    /**
+     * @brief Distribuciones de puntos disponibles.
+     */
+    enum class distribution
+    {
+        uniform,   // uniforme en [0, 1000)²
+        clustered, // nubes gaussianas alrededor de √n centros
+        grid,      // rejilla entera casi cuadrada
+        collinear, // puntos sobre una recta
+        duplicate  // pocas posiciones distintas repetidas muchas veces
+    };
+
+    /**
+     * @brief Convierte un nombre ("uniform", "clustered", ...) en una distribución.
+     * @param name nombre de la distribución
+     * @param d distribución (salida)
+     * @return true si el nombre es válido
+     */
+    bool parse_distribution(const std::string &name, distribution &d);
+
+    /**
+     * @brief Nombre de una distribución (inverso de parse_distribution).
+     * @param d distribución
+     * @return nombre
+     */
+    const char *distribution_name(distribution d);
+
+    /**
+     * @brief Genera n puntos de la distribución d de forma reproducible.
+     * @param d distribución
+     * @param n número de puntos
+     * @param seed semilla del generador
+     * @param ps vector a rellenar (se sustituye su contenido)
+     */
+    void generate_points(distribution d, std::size_t n, std::uint64_t seed, CyA::point_vector &ps);
+}
@@ -0,0 +1,399 @@
+/**
+ * @file point_reader.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de la lectura rápida de puntos.
+ */
+
+#include "point_reader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace EMST
+{
+    namespace
+    {
+        /**
+         * @class text_cursor
+         * @brief Recorre un texto en memoria contando líneas.
+         */
+        class text_cursor
+        {
+        private:
+            const char *p_;
+            const char *end_;
+            int line_;
+
+        public:
+            text_cursor(const char *begin, const char *end) : p_(begin), end_(end), line_(1) {}
+
+            /**
+             * @brief Salta espacios, tabuladores y saltos de línea.
+             */
+            void skip_blanks(void)
+            {
+                while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\r' || *p_ == '\n'))
+                {
+                    if (*p_ == '\n')
+                    {
+                        ++line_;
+                    }
+                    ++p_;
+                }
+            }
+
+            /**
+             * @brief Lee un entero.
+             * @return false si no hay un número válido
+             */
+            bool read(long long &value)
+            {
+                skip_blanks();
+
+                const std::from_chars_result r = std::from_chars(p_, end_, value);
+                if (r.ec != std::errc() || !at_separator(r.ptr))
+                {
+                    return false;
+                }
+
+                p_ = r.ptr;
+                return true;
+            }
+
+            /**
+             * @brief Lee un double (admite signo '+' inicial).
+             * @return false si no hay un número válido
+             */
+            bool read(double &value)
+            {
+                skip_blanks();
+
+                const char *first = p_;
+                if (first < end_ && *first == '+')
+                {
+                    ++first;
+                }
+
+                const std::from_chars_result r = std::from_chars(first, end_, value);
+                if (r.ec != std::errc() || !at_separator(r.ptr))
+                {
+                    return false;
+                }
+
+                p_ = r.ptr;
+                return true;
+            }
+
+            /**
+             * @brief Indica si quedan caracteres por leer (sin contar blancos).
+             */
+            bool at_end(void)
+            {
+                skip_blanks();
+                return p_ == end_;
+            }
+
+            inline int line(void) const { return line_; }
+
+            /**
+             * @brief Coordenadas que caben como mucho en el resto del texto
+             *        (cada una ocupa al menos un carácter y un separador).
+             */
+            inline size_t max_values(void) const { return (static_cast<size_t>(end_ - p_) + 1) / 2; }
+
+        private:
+            /**
+             * @brief El número debe terminar en un blanco o al final del texto.
+             */
+            bool at_separator(const char *q) const
+            {
+                return q == end_ || *q == ' ' || *q == '\t' || *q == '\r' || *q == '\n';
+            }
+        };
+
+        /**
+         * @brief Mensaje de error con el número de línea.
+         */
+        std::string line_error(int line, const std::string &msg)
+        {
+            return "línea " + std::to_string(line) + ": " + msg;
+        }
+
+        /**
+         * @brief Lee un conjunto "n / x y ..." desde la posición actual del cursor.
+         * @param cursor cursor sobre el texto
+         * @param ps vector de puntos a rellenar
+         * @param error mensaje de error (salida)
+         * @return true si el conjunto es válido
+         */
+        bool parse_one(text_cursor &cursor, CyA::point_vector &ps, std::string &error)
+        {
+            ps.clear();
+
+            long long n = 0;
+            if (!cursor.read(n) || n < 0)
+            {
+                error = line_error(cursor.line(), "se esperaba el número de puntos");
+                return false;
+            }
+
+            // La cabecera no es de fiar: no reservar más de lo que cabe en el texto
+            ps.reserve(std::min(static_cast<size_t>(n), cursor.max_values() / 2));
+
+            for (long long i = 0; i < n; ++i)
+            {
+                CyA::point p;
+
+                if (cursor.at_end())
+                {
+                    error = line_error(cursor.line(), "se esperaban " + std::to_string(n) +
+                                                          " puntos y solo hay " + std::to_string(i));
+                    return false;
+                }
+
+                if (!cursor.read(p.first) || !cursor.read(p.second))
+                {
+                    error = line_error(cursor.line(), "coordenada no válida en el punto " + std::to_string(i + 1));
+                    return false;
+                }
+
+                ps.push_back(p);
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Obtiene toda la entrada del descriptor (mmap si es posible) y la pasa a parse.
+         * @param fd descriptor abierto para lectura
+         * @param parse función que analiza el texto [begin, end)
+         * @param error mensaje de error (salida)
+         * @return resultado de parse, o false si la lectura falla
+         */
+        template <class Parser>
+        bool with_input(int fd, Parser parse, std::string &error)
+        {
+            struct stat st;
+
+            // Fichero regular: proyectarlo en memoria sin copiarlo
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+            {
+                const size_t length = static_cast<size_t>(st.st_size);
+                void *data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                if (data != MAP_FAILED)
+                {
+                    madvise(data, length, MADV_SEQUENTIAL);
+
+                    const char *text = static_cast<const char *>(data);
+                    const bool ok = parse(text, text + length);
+
+                    munmap(data, length);
+                    return ok;
+                }
+            }
+
+            // Tubería o terminal: leer por bloques grandes
+            std::vector<char> buffer;
+            size_t used = 0;
+
+            while (true)
+            {
+                if (buffer.size() - used < (1 << 16))
+                {
+                    buffer.resize(buffer.empty() ? (1 << 20) : buffer.size() * 2);
+                }
+
+                const ssize_t r = read(fd, buffer.data() + used, buffer.size() - used);
+
+                if (r < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    error = std::string("error de lectura: ") + std::strerror(errno);
+                    return false;
+                }
+
+                if (r == 0)
+                {
+                    break;
+                }
+
+                used += static_cast<size_t>(r);
+            }
+
+            return parse(buffer.data(), buffer.data() + used);
+        }
+    }
+
+    /**
+     * @brief Analiza el texto "n / x y ..." reservando n puntos de antemano.
+     * @param begin inicio del texto
+     * @param end fin del texto
+     * @param ps vector de puntos a rellenar
+     * @param error mensaje de error (salida)
+     * @return true si el texto es válido
+     */
+    bool parse_points(const char *begin, const char *end, CyA::point_vector &ps, std::string &error)
+    {
+        text_cursor cursor(begin, end);
+
+        return parse_one(cursor, ps, error);
+    }
+
+    /**
+     * @brief Analiza conjuntos "n / x y ..." consecutivos hasta el final del texto.
+     * @param begin inicio del texto
+     * @param end fin del texto
+     * @param sets conjuntos leídos (se añaden al final)
+     * @param error mensaje de error (salida)
+     * @return true si todos los conjuntos son válidos
+     */
+    bool parse_point_sets(const char *begin, const char *end, std::vector<CyA::point_vector> &sets, std::string &error)
+    {
+        text_cursor cursor(begin, end);
+
+        while (!cursor.at_end())
+        {
+            CyA::point_vector ps;
+
+            if (!parse_one(cursor, ps, error))
+            {
+                error = "conjunto " + std::to_string(sets.size() + 1) + ", " + error;
+                return false;
+            }
+
+            sets.push_back(std::move(ps));
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Analiza el texto "n / x1 ... xdim" con dim coordenadas por punto.
+     * @param begin inicio del texto
+     * @param end fin del texto
+     * @param dim número de coordenadas por punto
+     * @param coords coordenadas leídas
+     * @param error mensaje de error (salida)
+     * @return true si el texto es válido
+     */
+    bool parse_coordinates(const char *begin, const char *end, int dim, std::vector<double> &coords, std::string &error)
+    {
+        text_cursor cursor(begin, end);
+
+        coords.clear();
+
+        long long n = 0;
+        if (!cursor.read(n) || n < 0)
+        {
+            error = line_error(cursor.line(), "se esperaba el número de puntos");
+            return false;
+        }
+
+        // La cabecera no es de fiar: no reservar más de lo que cabe en el texto
+        coords.reserve(std::min(static_cast<size_t>(n), cursor.max_values() / dim) * dim);
+
+        for (long long i = 0; i < n; ++i)
+        {
+            if (cursor.at_end())
+            {
+                error = line_error(cursor.line(), "se esperaban " + std::to_string(n) +
+                                                      " puntos y solo hay " + std::to_string(i));
+                return false;
+            }
+
+            for (int k = 0; k < dim; ++k)
+            {
+                double value;
+                if (!cursor.read(value))
+                {
+                    error = line_error(cursor.line(), "coordenada no válida en el punto " + std::to_string(i + 1));
+                    return false;
+                }
+
+                coords.push_back(value);
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Lee toda la entrada del descriptor (mmap si es posible) y la analiza.
+     * @param fd descriptor abierto para lectura
+     * @param ps vector de puntos a rellenar
+     * @param error mensaje de error (salida)
+     * @return true si la lectura fue correcta
+     */
+    bool read_points(int fd, CyA::point_vector &ps, std::string &error)
+    {
+        return with_input(fd, [&](const char *begin, const char *end) {
+            return parse_points(begin, end, ps, error);
+        }, error);
+    }
+
+    /**
+     * @brief Lee todos los conjuntos de puntos concatenados del descriptor.
+     * @param fd descriptor abierto para lectura
+     * @param sets conjuntos leídos (se añaden al final)
+     * @param error mensaje de error (salida)
+     * @return true si la lectura fue correcta
+     */
+    bool read_point_sets(int fd, std::vector<CyA::point_vector> &sets, std::string &error)
+    {
+        return with_input(fd, [&](const char *begin, const char *end) {
+            return parse_point_sets(begin, end, sets, error);
+        }, error);
+    }
+
+    /**
+     * @brief Lee del descriptor un conjunto de puntos de dimensión dim.
+     * @param fd descriptor abierto para lectura
+     * @param dim número de coordenadas por punto
+     * @param coords coordenadas leídas
+     * @param error mensaje de error (salida)
+     * @return true si la lectura fue correcta
+     */
+    bool read_coordinates(int fd, int dim, std::vector<double> &coords, std::string &error)
+    {
+        return with_input(fd, [&](const char *begin, const char *end) {
+            return parse_coordinates(begin, end, dim, coords, error);
+        }, error);
+    }
+
+    /**
+     * @brief Abre el fichero y lo lee con read_points(fd, ...).
+     * @param filename nombre del fichero
+     * @param ps vector de puntos a rellenar
+     * @param error mensaje de error (salida)
+     * @return true si la lectura fue correcta
+     */
+    bool read_points(const std::string &filename, CyA::point_vector &ps, std::string &error)
+    {
+        const int fd = open(filename.c_str(), O_RDONLY);
+
+        if (fd < 0)
+        {
+            error = filename + ": " + std::strerror(errno);
+            return false;
+        }
+
+        const bool ok = read_points(fd, ps, error);
+        close(fd);
+
+        return ok;
+    }
+}
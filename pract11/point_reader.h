@@ -0,0 +1,88 @@
+/**
+ * @file point_reader.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Lectura rápida de conjuntos de puntos en el formato de texto "n / x y".
+ *
+ * Alternativa a operator>>(istream&, point_vector&) para ficheros grandes: lee
+ * toda la entrada de una vez (mmap si es un fichero regular, read() por bloques
+ * si es una tubería), convierte los números con std::from_chars y reserva los n
+ * puntos indicados en la cabecera. Los errores indican la línea en que ocurren.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "point_types.h"
+
+namespace EMST
+{
+    /**
+     * @brief Lee un conjunto de puntos desde un descriptor de fichero.
+     * @param fd descriptor abierto para lectura (0 para stdin)
+     * @param ps vector de puntos a rellenar
+     * @param error mensaje de error (salida) si la lectura falla
+     * @return true si la lectura fue correcta
+     */
+    bool read_points(int fd, CyA::point_vector &ps, std::string &error);
+
+    /**
+     * @brief Lee un conjunto de puntos desde un fichero.
+     * @param filename nombre del fichero
+     * @param ps vector de puntos a rellenar
+     * @param error mensaje de error (salida) si la lectura falla
+     * @return true si la lectura fue correcta
+     */
+    bool read_points(const std::string &filename, CyA::point_vector &ps, std::string &error);
+
+    /**
+     * @brief Lee todos los conjuntos de puntos concatenados ("n / x y" tras "n / x y"...).
+     * @param fd descriptor abierto para lectura (0 para stdin)
+     * @param sets conjuntos leídos (se añaden al final)
+     * @param error mensaje de error (salida) si la lectura falla
+     * @return true si la lectura fue correcta
+     */
+    bool read_point_sets(int fd, std::vector<CyA::point_vector> &sets, std::string &error);
+
+    /**
+     * @brief Lee un conjunto de puntos de dimensión dim ("n / x1 ... xdim").
+     * @param fd descriptor abierto para lectura (0 para stdin)
+     * @param dim número de coordenadas por punto
+     * @param coords n * dim coordenadas, punto a punto
+     * @param error mensaje de error (salida) si la lectura falla
+     * @return true si la lectura fue correcta
+     */
+    bool read_coordinates(int fd, int dim, std::vector<double> &coords, std::string &error);
+
+    /**
+     * @brief Convierte un texto en memoria con el formato "n / x y" en un vector de puntos.
+     * @param begin inicio del texto
+     * @param end fin del texto
+     * @param ps vector de puntos a rellenar
+     * @param error mensaje de error (salida) si el texto no es válido
+     * @return true si el texto es válido
+     */
+    bool parse_points(const char *begin, const char *end, CyA::point_vector &ps, std::string &error);
+
+    /**
+     * @brief Convierte un texto con varios conjuntos "n / x y" consecutivos.
+     * @param begin inicio del texto
+     * @param end fin del texto
+     * @param sets conjuntos leídos (se añaden al final)
+     * @param error mensaje de error (salida) si el texto no es válido
+     * @return true si el texto es válido
+     */
+    bool parse_point_sets(const char *begin, const char *end, std::vector<CyA::point_vector> &sets, std::string &error);
+
+    /**
+     * @brief Convierte un texto "n / x1 ... xdim" en n * dim coordenadas consecutivas.
+     * @param begin inicio del texto
+     * @param end fin del texto
+     * @param dim número de coordenadas por punto
+     * @param coords coordenadas leídas (se sustituye su contenido)
+     * @param error mensaje de error (salida) si el texto no es válido
+     * @return true si el texto es válido
+     */
+    bool parse_coordinates(const char *begin, const char *end, int dim, std::vector<double> &coords, std::string &error);
+}
@@ -5,20 +5,100 @@
  */
 
 #include "point_set.h"
+#include "delaunay.h"
+#include "boruvka.h"
+#include "parallel_sort.h"
+#include "distance_kernel.h"
+#include "edge_spill.h"
+#include "wspd.h"
+#include "tiling.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iomanip>
+#include <limits>
+#include <numeric>
 #include <fstream>
 #include <sstream>
+#include <thread>
+#include <utility>
 
 namespace EMST
 {
+    /**
+     * @brief Convierte un nombre de motor en su valor del enumerado.
+     * @param name nombre del motor
+     * @param e motor reconocido (salida)
+     * @return true si el nombre es válido
+     */
+    bool parse_engine(const std::string &name, engine &e)
+    {
+        if (name == "kruskal")
+        {
+            e = engine::kruskal;
+        }
+        else if (name == "delaunay")
+        {
+            e = engine::delaunay;
+        }
+        else if (name == "boruvka")
+        {
+            e = engine::boruvka;
+        }
+        else if (name == "filter")
+        {
+            e = engine::filter;
+        }
+        else if (name == "prim")
+        {
+            e = engine::prim;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Nombre de un motor.
+     * @param e motor
+     * @return nombre
+     */
+    const char *engine_name(engine e)
+    {
+        switch (e)
+        {
+        case engine::kruskal:
+            return "kruskal";
+        case engine::delaunay:
+            return "delaunay";
+        case engine::boruvka:
+            return "boruvka";
+        case engine::filter:
+            return "filter";
+        case engine::prim:
+            return "prim";
+        }
+
+        return "";
+    }
+
     /**
      * @brief Constructor: copia el vector de puntos al objeto.
      * @param points vector de puntos de entrada
      */
-    point_set::point_set(const CyA::point_vector &points) : CyA::point_vector(points), emst_()
+    point_set::point_set(const CyA::point_vector &points) : CyA::point_vector(points), emst_(), arcs_(), threads_(1), stats_()
+    {
+    }
+
+    /**
+     * @brief Constructor: mueve el vector de puntos al objeto.
+     * @param points vector de puntos de entrada
+     */
+    point_set::point_set(CyA::point_vector &&points) : CyA::point_vector(std::move(points)), emst_(), arcs_(), threads_(1), stats_()
     {
     }
 
@@ -29,6 +109,16 @@ namespace EMST
     {
     }
 
+    /**
+     * @brief Sustituye los puntos y descarta el árbol anterior, conservando los búferes.
+     * @param points nuevo vector de puntos
+     */
+    void point_set::reset(CyA::point_vector &&points)
+    {
+        CyA::point_vector::operator=(std::move(points));
+        emst_.clear();
+    }
+
     /**
      * @brief Calcula la distancia euclídea entre dos puntos (arco).
      * @param a arco con dos puntos
@@ -45,76 +135,138 @@ namespace EMST
     }
 
     /**
-     * @brief Construye todas las aristas posibles entre pares de puntos y las ordena por peso.
-     * @param av vector a rellenar con aristas ponderadas (peso, arco)
+     * @brief Calcula la distancia euclídea entre dos puntos dados por su índice.
+     * @param a arco con dos índices de puntos
+     * @return distancia euclídea (double)
      */
-    void point_set::compute_arc_vector(CyA::arc_vector &av) const
+    double point_set::euclidean_distance(const CyA::index_arc& a) const
     {
-        // Vaciar el vector de salida
-        av.clear();
+        return euclidean_distance(std::make_pair((*this)[a.first], (*this)[a.second]));
+    }
 
+    /**
+     * @brief Construye todas las aristas posibles entre pares de puntos (sin ordenar).
+     *
+     * El vector se dimensiona de una vez con las n(n-1)/2 aristas y las filas i
+     * de la matriz de parejas se reparten en bloques contiguos entre threads_
+     * hilos, de modo que cada hilo escribe en su propia porción sin realojar.
+     * @param av vector a rellenar con aristas ponderadas (distancia al cuadrado, i, j)
+     */
+    void point_set::compute_arc_vector(CyA::index_arc_vector &av) const
+    {
         // Tamaño del conjunto de puntos
         const int n = static_cast<int>(size());
 
-        // Recorrer pares i<j para generar cada arista una vez
-        for (int i = 0; i < n - 1; ++i)
+        // Dimensionar las n(n-1)/2 aristas de una vez
+        const size_t total = n > 1 ? static_cast<size_t>(n) * (n - 1) / 2 : 0;
+        av.resize(total);
+
+        // Copia estructura-de-vectores de las coordenadas para el núcleo SIMD
+        std::vector<double> xs(n);
+        std::vector<double> ys(n);
+        for (int i = 0; i < n; ++i)
         {
-            const CyA::point &p_i = (*this)[i];
+            xs[i] = (*this)[i].first;
+            ys[i] = (*this)[i].second;
+        }
 
-            for (int j = i + 1; j < n; ++j)
-            {
-                const CyA::point &p_j = (*this)[j];
+        const int threads = std::max(1, std::min(threads_, n - 1));
+
+        if (threads == 1)
+        {
+            compute_arc_rows(av, xs, ys, 0, n - 1);
+            return;
+        }
+
+        // Repartir filas para que cada hilo genere ~total/threads aristas
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
 
-                // Calculardistancia euclídea
-                const double dist = euclidean_distance(std::make_pair(p_i, p_j));
+        int first = 0;
+        size_t generated = 0;
 
-                // Añadir par (distancia, arco)
-                av.push_back(std::make_pair(dist, std::make_pair(p_i, p_j)));
+        for (int t = 0; t < threads && first < n - 1; ++t)
+        {
+            const size_t target = total * (t + 1) / threads;
+
+            int last = first;
+            while (last < n - 1 && (generated < target || last == first))
+            {
+                generated += static_cast<size_t>(n - 1 - last);
+                ++last;
             }
+
+            if (t == threads - 1)
+            {
+                last = n - 1;
+            }
+
+            workers.emplace_back([this, &av, &xs, &ys, first, last]() {
+                compute_arc_rows(av, xs, ys, first, last);
+            });
+
+            first = last;
         }
 
-        // Ordenar por el primer elemento del pair (distancia ascendente)
-        std::sort(av.begin(), av.end());
+        for (std::thread &w : workers)
+        {
+            w.join();
+        }
     }
 
     /**
-     * @brief Busca en el vector de sub_trees los subárboles que contienen cada extremo del arco a.
-     * @param st bosque actual
-     * @param a arco cuyos extremos se buscan
-     * @param i referencia para devolver índice del subárbol que contiene a.first
-     * @param j referencia para devolver índice del subárbol que contiene a.second
+     * @brief Genera las aristas (i, j) con i en [first, last) y j > i en su posición de av.
+     *
+     * Las distancias al cuadrado de cada fila se calculan por bloques con el
+     * núcleo vectorizado; el peso guardado es la distancia al cuadrado, que
+     * ordena igual que la distancia y evita una raíz cuadrada por pareja.
+     * @param av vector ya dimensionado con n(n-1)/2 aristas
+     * @param xs coordenadas x de todos los puntos
+     * @param ys coordenadas y de todos los puntos
+     * @param first primera fila
+     * @param last fila siguiente a la última
      */
-    void point_set::find_incident_subtrees(const forest& st, const CyA::arc &a, int& i, int& j) const
+    void point_set::compute_arc_rows(CyA::index_arc_vector &av,
+                                     const std::vector<double> &xs,
+                                     const std::vector<double> &ys,
+                                     int first, int last) const
     {
-        // Inicializamos a -1 (no encontrados)
-        i = -1;
-        j = -1;
+        const int n = static_cast<int>(size());
 
-        const int m = static_cast<int>(st.size());
+        // Posición de la primera arista de la fila first: suma de las filas anteriores
+        size_t k = static_cast<size_t>(first) * (2 * static_cast<size_t>(n) - first - 1) / 2;
 
-        // Iterar sobre cada sub_tree buscando los puntos
-        for (int idx = 0; idx < m; ++idx)
+        double block[DISTANCE_BLOCK];
+
+        // Recorrer pares i<j para generar cada arista una vez
+        for (int i = first; i < last; ++i)
         {
-            // Si aún no se encuentra i y el sub_tree idx contiene a.first, lo asigno
-            if (i == -1 && st[idx].contains(a.first))
+            for (int j0 = i + 1; j0 < n; j0 += DISTANCE_BLOCK)
             {
-                i = idx;
-            }
+                const int count = std::min(DISTANCE_BLOCK, n - j0);
 
-            // Si aún no se encuentra j y el sub_tree idx contiene a.second, lo asigno
-            if (j == -1 && st[idx].contains(a.second))
-            {
-                j = idx;
-            }
+                // Distancias al cuadrado de i a los puntos j0 .. j0 + count - 1
+                squared_distances(xs.data() + j0, ys.data() + j0, xs[i], ys[i], count, block);
 
-            // Si ambos encontrados, salir del bucle
-            if (i != -1 && j != -1)
-            {
-                break;
+                for (int b = 0; b < count; ++b)
+                {
+                    av[k++] = CyA::weighted_index_arc(block[b], i, j0 + b);
+                }
             }
         }
     }
 
+    /**
+     * @brief Triangula el conjunto de puntos y devuelve sus aristas (sin ordenar).
+     * @param av vector a rellenar con aristas ponderadas (distancia al cuadrado, i, j)
+     */
+    void point_set::compute_delaunay_arc_vector(CyA::index_arc_vector &av) const
+    {
+        // El EMST es un subgrafo de la triangulación: basta con sus ~3n aristas
+        const delaunay dt(*this);
+        dt.get_edges(av);
+    }
+
     /**
      * @brief Fusiona los sub-árboles i y j en el bosque st usando el arco proporcionado.
      * @param st bosque (se modificará)
@@ -134,67 +286,1084 @@ namespace EMST
             return;
         }
 
-        // Para mantener índices válidos al borrar, borramos el índice mayor para no invalidar el menor.
-        if (i < j)
+        // El resultado queda en el índice menor; el mayor se vacía
+        const int kept = std::min(i, j);
+        const int removed = std::max(i, j);
+
+        st[kept].merge(std::move(st[removed]), wa);
+
+        // Sin desplazar el resto: el último sub-árbol ocupa el hueco
+        if (removed != static_cast<int>(st.size()) - 1)
         {
-            // Fusionar j en i, y borrar j
-            st[i].merge(st[j], wa);
-            st.erase(st.begin() + j);
+            st[removed] = std::move(st.back());
         }
-        else
+        st.pop_back();
+    }
+
+    /**
+     * @brief Colapsa los puntos repetidos y obtiene el EMST de los distintos con el motor e.
+     * @param e motor que genera las aristas candidatas
+     */
+    void point_set::EMST(engine e)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        std::vector<std::uint32_t> first_of;
+        const std::size_t duplicates = find_duplicates(first_of);
+        const double dedup_seconds = seconds_since(start);
+
+        if (duplicates == 0)
+        {
+            solve(e);
+            stats_.dedup_seconds = dedup_seconds;
+            return;
+        }
+
+        // Motor sobre los puntos distintos, en su orden original (la numeración
+        // es creciente, así que las aristas conservan i < j)
+        std::vector<std::uint32_t> original;
+        original.reserve(size() - duplicates);
+
+        CyA::point_vector distinct;
+        distinct.reserve(size() - duplicates);
+
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            if (first_of[i] == i)
+            {
+                original.push_back(static_cast<std::uint32_t>(i));
+                distinct.push_back((*this)[i]);
+            }
+        }
+
+        point_set reduced(std::move(distinct));
+        reduced.set_threads(threads_);
+        reduced.solve(e);
+
+        // Aristas de peso 0 (las primeras que aceptaría Kruskal) y después las del motor
+        emst_.clear();
+        emst_.reserve(size() - 1);
+
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            if (first_of[i] != i)
+            {
+                emst_.emplace_back(first_of[i], static_cast<std::uint32_t>(i));
+            }
+        }
+
+        for (const CyA::index_arc &a : reduced.emst_)
+        {
+            emst_.emplace_back(original[a.first], original[a.second]);
+        }
+
+        stats_ = reduced.stats_;
+        stats_.points = size();
+        stats_.duplicates = duplicates;
+        stats_.dedup_seconds = dedup_seconds;
+    }
+
+    /**
+     * @brief Ordena los índices por coordenadas; cada grupo de iguales apunta al menor índice.
+     * @param first_of primera aparición de cada punto (salida)
+     * @return número de puntos repetidos
+     */
+    std::size_t point_set::find_duplicates(std::vector<std::uint32_t> &first_of) const
+    {
+        const std::size_t n = size();
+
+        std::vector<std::uint32_t> order(n);
+        first_of.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
         {
-            // Fusionar i en j, y borrar i
-            st[j].merge(st[i], wa);
-            st.erase(st.begin() + i);
+            order[i] = static_cast<std::uint32_t>(i);
+            first_of[i] = static_cast<std::uint32_t>(i);
         }
+
+        // Desempate por índice: el primero de cada grupo es la primera aparición
+        std::sort(order.begin(), order.end(), [this](std::uint32_t a, std::uint32_t b) {
+            const CyA::point &pa = (*this)[a];
+            const CyA::point &pb = (*this)[b];
+            return pa != pb ? pa < pb : a < b;
+        });
+
+        std::size_t duplicates = 0;
+        for (std::size_t k = 1; k < n; ++k)
+        {
+            if ((*this)[order[k]] == (*this)[order[k - 1]])
+            {
+                first_of[order[k]] = first_of[order[k - 1]];
+                ++duplicates;
+            }
+        }
+
+        return duplicates;
     }
 
     /**
      * @brief Ejecuta Kruskal adaptado para obtener el EMST y almacenarlo en emst_.
+     *
+     * Las componentes del bosque se mantienen en un disjoint_set indexado por
+     * la posición de cada punto, de modo que comprobar si una arista une dos
+     * sub-árboles distintos tiene coste casi constante. Los tiempos y
+     * contadores de cada fase quedan en stats_.
+     * @param e motor que genera las aristas candidatas
      */
-    void point_set::EMST(void)
+    void point_set::solve(engine e)
     {
-        // Generar el vector de aristas ponderadas entre todos los pares de puntos
-        CyA::arc_vector av;
-        compute_arc_vector(av);
+        stats_ = emst_stats();
+        stats_.engine = engine_name(e);
+        stats_.points = size();
+        stats_.threads = threads_;
 
-        // Inicializar el bosque, donde cada punto es un sub-árbol independiente
-        forest st;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-        // Cada punto comienza como un sub-árbol aislado
-        for (const CyA::point &p : *this)
+        // Borůvka y Prim no necesitan lista de aristas
+        if (e == engine::boruvka)
+        {
+            boruvka b(*this);
+            b.run(emst_);
+
+            stats_.mst_seconds = seconds_since(start);
+            stats_.finds = b.get_components().find_count();
+            stats_.unions = b.get_components().union_count();
+            return;
+        }
+
+        if (e == engine::prim)
+        {
+            prim();
+
+            stats_.mst_seconds = seconds_since(start);
+            stats_.edges_scanned = size() > 1 ? static_cast<std::uint64_t>(size()) * (size() - 1) / 2 : 0;
+            return;
+        }
+
+        // Generar el vector de aristas candidatas (arcs_ conserva su capacidad entre llamadas)
+        CyA::index_arc_vector &av = arcs_;
+
+        if (e == engine::delaunay)
+        {
+            compute_delaunay_arc_vector(av);
+        }
+        else
+        {
+            compute_arc_vector(av);
+        }
+
+        stats_.generate_seconds = seconds_since(start);
+        stats_.edges_generated = av.size();
+
+        // Filter-Kruskal solo ordena las aristas que llegan a necesitarse
+        if (e == engine::filter)
+        {
+            const int n = static_cast<int>(size());
+            disjoint_set ds(n);
+
+            emst_.clear();
+            emst_.reserve(n > 0 ? n - 1 : 0);
+
+            start = std::chrono::steady_clock::now();
+            filter_kruskal(av.begin(), av.end(), ds);
+
+            // Ordenación y recorrido van intercalados: todo cuenta como recorrido
+            stats_.mst_seconds = seconds_since(start);
+            stats_.finds = ds.find_count();
+            stats_.unions = ds.union_count();
+            return;
+        }
+
+        // Ordenar por peso (distancia ascendente) y recorrer
+        start = std::chrono::steady_clock::now();
+        parallel_sort(av, threads_, CyA::arc_order(*this));
+        stats_.sort_seconds = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        kruskal(av);
+        stats_.mst_seconds = seconds_since(start);
+    }
+
+    /**
+     * @brief Franjas con el mismo número de puntos, EMST local, parejas de franjas cercanas y Kruskal final.
+     * @param tiles número de franjas
+     * @param workers trabajadores
+     * @param error mensaje de error (salida)
+     * @return false si falla algún trabajador
+     */
+    bool point_set::EMST_tiled(int tiles, tile_workers &workers, std::string &error)
+    {
+        const std::size_t n = size();
+
+        stats_ = emst_stats();
+        stats_.engine = "tiled";
+        stats_.points = n;
+        stats_.threads = workers.size();
+
+        emst_.clear();
+        if (n < 2)
+        {
+            return true;
+        }
+
+        // Con franjas muy pequeñas cuesta más repartir que resolver
+        const std::size_t strips = std::max<std::size_t>(1, std::min<std::size_t>(tiles, n / TILE_MIN_POINTS));
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        // Orden por (x, y, índice): cada franja es un tramo consecutivo
+        std::vector<std::uint32_t> order(n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            order[k] = static_cast<std::uint32_t>(k);
+        }
+        std::sort(order.begin(), order.end(), [this](std::uint32_t a, std::uint32_t b) {
+            const CyA::point &pa = (*this)[a];
+            const CyA::point &pb = (*this)[b];
+            return pa != pb ? pa < pb : a < b;
+        });
+
+        std::vector<std::size_t> first(strips + 1);
+        for (std::size_t s = 0; s <= strips; ++s)
+        {
+            first[s] = s * n / strips;
+        }
+
+        CyA::index_arc_vector &av = arcs_;
+        av.clear();
+
+        auto add_edge = [&](std::uint32_t a, std::uint32_t b) {
+            const double dx = (*this)[a].first - (*this)[b].first;
+            const double dy = (*this)[a].second - (*this)[b].second;
+            const double w = dx * dx + dy * dy;
+
+            av.emplace_back(w, std::min(a, b), std::max(a, b));
+            return w;
+        };
+
+        // Fase 1: EMST de cada franja. Los puntos de cada petición van en su orden
+        // original para que el desempate local de arc_order coincida con el global
+        std::vector<CyA::point_vector> jobs(strips);
+        std::vector<std::vector<std::uint32_t>> members(strips);
+        std::vector<std::uint32_t> strip_of(n);
+        for (std::size_t s = 0; s < strips; ++s)
+        {
+            members[s].assign(order.begin() + first[s], order.begin() + first[s + 1]);
+            std::sort(members[s].begin(), members[s].end());
+            for (std::uint32_t k : members[s])
+            {
+                strip_of[k] = static_cast<std::uint32_t>(s);
+            }
+            for (std::uint32_t k : members[s])
+            {
+                jobs[s].push_back((*this)[k]);
+            }
+        }
+
+        std::vector<CyA::index_tree> trees;
+        if (!workers.solve(jobs, trees, error))
+        {
+            return false;
+        }
+
+        // Mayor arista (al cuadrado) de cada árbol local y de cada conector: la
+        // arista más corta del último punto de una franja a la franja siguiente
+        std::vector<double> strip_max(strips, 0.0);
+        std::vector<double> connector(strips, 0.0);
+
+        for (std::size_t s = 0; s < strips; ++s)
+        {
+            for (const CyA::index_arc &a : trees[s])
+            {
+                strip_max[s] = std::max(strip_max[s], add_edge(members[s][a.first], members[s][a.second]));
+            }
+
+            if (s + 1 < strips)
+            {
+                // Recorrido en x creciente hasta que la separación en x supera la mejor distancia
+                const CyA::point &a = (*this)[order[first[s + 1] - 1]];
+                double best = std::numeric_limits<double>::infinity();
+
+                for (std::size_t k = first[s + 1]; k < first[s + 2]; ++k)
+                {
+                    const CyA::point &b = (*this)[order[k]];
+                    const double dx = b.first - a.first;
+                    const double dy = b.second - a.second;
+
+                    if (dx * dx >= best)
+                    {
+                        break;
+                    }
+                    best = std::min(best, dx * dx + dy * dy);
+                }
+
+                connector[s] = best;
+            }
+        }
+
+        // Fase 2: cada par de franjas (i, j) a distancia <= r_ij, solo la banda que
+        // mira a la otra. r_ij es la mayor arista del camino entre ambas por los
+        // árboles locales y los conectores de i a j: ninguna arista del EMST entre
+        // ellas puede ser más larga que la mayor arista de otro camino
+        jobs.clear();
+        members.clear();
+
+        for (std::size_t i = 0; i + 1 < strips; ++i)
+        {
+            const double right_x = (*this)[order[first[i + 1] - 1]].first;
+            double limit = strip_max[i];
+
+            for (std::size_t j = i + 1; j < strips; ++j)
+            {
+                limit = std::max(limit, std::max(connector[j - 1], strip_max[j]));
+
+                // Margen para el redondeo de la raíz
+                const double reach = std::sqrt(limit) * (1.0 + 1e-9);
+
+                const double left_x = (*this)[order[first[j]]].first;
+                if (left_x - right_x > reach)
+                {
+                    continue;
+                }
+
+                std::vector<std::uint32_t> band;
+                for (std::size_t k = first[i + 1]; k > first[i] && (*this)[order[k - 1]].first >= left_x - reach; --k)
+                {
+                    band.push_back(order[k - 1]);
+                }
+                for (std::size_t k = first[j]; k < first[j + 1] && (*this)[order[k]].first <= right_x + reach; ++k)
+                {
+                    band.push_back(order[k]);
+                }
+                std::sort(band.begin(), band.end());
+
+                jobs.emplace_back();
+                for (std::uint32_t k : band)
+                {
+                    jobs.back().push_back((*this)[k]);
+                }
+                members.push_back(std::move(band));
+            }
+        }
+
+        if (!workers.solve(jobs, trees, error))
+        {
+            return false;
+        }
+
+        // Solo interesan las aristas que cruzan de una franja a la otra
+        for (std::size_t p = 0; p < jobs.size(); ++p)
+        {
+            for (const CyA::index_arc &a : trees[p])
+            {
+                if (strip_of[members[p][a.first]] != strip_of[members[p][a.second]])
+                {
+                    add_edge(members[p][a.first], members[p][a.second]);
+                }
+            }
+        }
+
+        stats_.generate_seconds = seconds_since(start);
+        stats_.edges_generated = av.size();
+
+        start = std::chrono::steady_clock::now();
+        parallel_sort(av, threads_, CyA::arc_order(*this));
+        stats_.sort_seconds = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        kruskal(av);
+        stats_.mst_seconds = seconds_since(start);
+
+        return true;
+    }
+
+    /**
+     * @brief Kruskal sobre las aristas representantes de los pares bien separados.
+     * @param epsilon error relativo admitido
+     */
+    void point_set::EMST_approx(double epsilon)
+    {
+        stats_ = emst_stats();
+        stats_.engine = "approx";
+        stats_.points = size();
+        stats_.threads = threads_;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        CyA::index_arc_vector &av = arcs_;
+        const wspd pairs(*this, epsilon);
+        pairs.get_edges(av);
+
+        stats_.generate_seconds = seconds_since(start);
+        stats_.edges_generated = av.size();
+
+        start = std::chrono::steady_clock::now();
+        parallel_sort(av, threads_, CyA::arc_order(*this));
+        stats_.sort_seconds = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        kruskal(av);
+        stats_.mst_seconds = seconds_since(start);
+    }
+
+    /**
+     * @brief Kruskal externo: tramos ordenados en disco y mezcla k-aria hasta completar el árbol.
+     * @param budget memoria para las aristas (bytes)
+     * @param dir directorio temporal
+     * @param error mensaje de error (salida)
+     * @return false si falla la E/S de los tramos
+     */
+    bool point_set::EMST_external(std::size_t budget, const std::string &dir, std::string &error)
+    {
+        const int n = static_cast<int>(size());
+
+        stats_ = emst_stats();
+        stats_.engine = "external";
+        stats_.points = size();
+        stats_.threads = threads_;
+
+        emst_.clear();
+        emst_.reserve(n > 0 ? n - 1 : 0);
+
+        std::vector<double> xs(n);
+        std::vector<double> ys(n);
+        for (int k = 0; k < n; ++k)
+        {
+            xs[k] = (*this)[k].first;
+            ys[k] = (*this)[k].second;
+        }
+
+        // Bloque de aristas en memoria (al menos una fila de bloques del núcleo)
+        const std::size_t capacity = std::max<std::size_t>(budget / sizeof(CyA::weighted_index_arc), DISTANCE_BLOCK);
+
+        CyA::index_arc_vector &av = arcs_;
+        av.clear();
+        av.reserve(capacity);
+
+        const CyA::arc_order order(*this);
+        edge_spill spill(dir, order);
+        int i = 0;
+        int j = 1;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        while (i < n - 1)
+        {
+            fill_arc_block(av, xs, ys, i, j);
+            stats_.edges_generated += av.size();
+
+            std::chrono::steady_clock::time_point sort_start = std::chrono::steady_clock::now();
+            parallel_sort(av, threads_, order);
+            stats_.sort_seconds += seconds_since(sort_start);
+
+            // Todas las aristas en un solo bloque: Kruskal en memoria
+            if (i >= n - 1 && spill.runs() == 0)
+            {
+                stats_.generate_seconds = seconds_since(start) - stats_.sort_seconds;
+
+                start = std::chrono::steady_clock::now();
+                kruskal(av);
+                stats_.mst_seconds = seconds_since(start);
+                return true;
+            }
+
+            if (!spill.append(av))
+            {
+                error = spill.error();
+                return false;
+            }
+
+            av.clear();
+        }
+
+        stats_.generate_seconds = seconds_since(start) - stats_.sort_seconds;
+        stats_.spilled_bytes = spill.bytes_spilled();
+        stats_.runs = spill.runs();
+
+        // El bloque ya no hace falta: su presupuesto pasa a los búferes de la mezcla
+        CyA::index_arc_vector().swap(av);
+
+        start = std::chrono::steady_clock::now();
+
+        if (!spill.start_merge(budget))
+        {
+            error = spill.error();
+            return false;
+        }
+
+        disjoint_set ds(n);
+        CyA::weighted_index_arc a;
+
+        while (ds.components() > 1 && spill.next(a))
+        {
+            ++stats_.edges_scanned;
+
+            if (ds.unite(a.i, a.j))
+            {
+                emst_.emplace_back(a.i, a.j);
+            }
+        }
+
+        stats_.mst_seconds = seconds_since(start);
+        stats_.finds = ds.find_count();
+        stats_.unions = ds.union_count();
+
+        // next() devuelve false tanto al agotar las aristas como tras un fallo de lectura
+        if (!spill.error().empty())
+        {
+            error = spill.error();
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Añade aristas (i, j) con j > i en orden de filas hasta llenar la capacidad de av.
+     * @param av vector de aristas
+     * @param xs coordenadas x
+     * @param ys coordenadas y
+     * @param i fila actual (se avanza)
+     * @param j primera columna pendiente (se avanza)
+     */
+    void point_set::fill_arc_block(CyA::index_arc_vector &av,
+                                   const std::vector<double> &xs,
+                                   const std::vector<double> &ys,
+                                   int &i, int &j) const
+    {
+        const int n = static_cast<int>(size());
+
+        double block[DISTANCE_BLOCK];
+
+        while (i < n - 1)
+        {
+            const std::size_t room = av.capacity() - av.size();
+            if (room == 0)
+            {
+                return;
+            }
+
+            const int count = static_cast<int>(std::min<std::size_t>(room, std::min(DISTANCE_BLOCK, n - j)));
+
+            squared_distances(xs.data() + j, ys.data() + j, xs[i], ys[i], count, block);
+
+            for (int b = 0; b < count; ++b)
+            {
+                av.emplace_back(block[b], i, j + b);
+            }
+
+            j += count;
+            if (j == n)
+            {
+                ++i;
+                j = i + 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Filter-Kruskal: parte el rango por un pivote, resuelve la mitad ligera y
+     *        filtra la pesada descartando las aristas internas a una componente.
+     * @param begin inicio del rango de aristas candidatas (sin ordenar)
+     * @param end fin del rango
+     * @param ds componentes actuales (se modifica)
+     */
+    void point_set::filter_kruskal(CyA::index_arc_vector::iterator begin,
+                                   CyA::index_arc_vector::iterator end,
+                                   disjoint_set &ds)
+    {
+        if (ds.components() <= 1)
+        {
+            return;
+        }
+
+        const CyA::arc_order order(*this);
+
+        // Rango pequeño: Kruskal clásico ordenando por completo
+        if (end - begin <= FILTER_KRUSKAL_THRESHOLD)
         {
-            sub_tree s;
-            s.add_point(p); // sub-árbol con un solo vértice
+            std::sort(begin, end, order);
 
-            st.push_back(s);
+            for (CyA::index_arc_vector::iterator it = begin; it != end && ds.components() > 1; ++it)
+            {
+                ++stats_.edges_scanned;
+
+                if (ds.unite(it->i, it->j))
+                {
+                    emst_.emplace_back(it->i, it->j);
+                }
+            }
+
+            return;
+        }
+
+        // Pivote: mediana de tres aristas (todas distintas en el orden total)
+        CyA::weighted_index_arc a = *begin;
+        CyA::weighted_index_arc b = *(begin + (end - begin) / 2);
+        CyA::weighted_index_arc c = *(end - 1);
+
+        if (order(b, a))
+        {
+            std::swap(a, b);
+        }
+        if (order(c, b))
+        {
+            std::swap(b, c);
+        }
+        if (order(b, a))
+        {
+            std::swap(a, b);
+        }
+
+        const CyA::weighted_index_arc pivot = b;
+
+        // Mitad ligera: aristas <= pivote (nunca vacía ni completa)
+        CyA::index_arc_vector::iterator mid = std::partition(begin, end, [&](const CyA::weighted_index_arc &e) {
+            return !order(pivot, e);
+        });
+
+        filter_kruskal(begin, mid, ds);
+
+        if (ds.components() <= 1)
+        {
+            return;
         }
 
+        // Filtrar la mitad pesada: fuera las aristas que ya cerrarían un ciclo
+        CyA::index_arc_vector::iterator last = std::partition(mid, end, [&](const CyA::weighted_index_arc &e) {
+            return !ds.same(e.i, e.j);
+        });
+
+        filter_kruskal(mid, last, ds);
+    }
+
+    /**
+     * @brief Recorre las aristas por peso creciente uniendo componentes del disjoint_set.
+     * @param av aristas candidatas ordenadas por peso creciente
+     */
+    void point_set::kruskal(const CyA::index_arc_vector &av)
+    {
+        const int n = static_cast<int>(size());
+
+        // Cada punto comienza como una componente aislada
+        disjoint_set ds(n);
+
+        emst_.clear();
+        emst_.reserve(n > 0 ? n - 1 : 0);
+
         // Recorremos aristas por peso creciente (Kruskal)
-        for (const CyA::weigthed_arc &a : av)
+        for (const CyA::weighted_index_arc &a : av)
         {
-            int i, j;
+            // Con n-1 aristas aceptadas el árbol está completo
+            if (ds.components() <= 1)
+            {
+                break;
+            }
+
+            ++stats_.edges_scanned;
+
+            // Si pertenecen a componentes distintas, se unen y la arista pasa al árbol
+            if (ds.unite(a.i, a.j))
+            {
+                emst_.emplace_back(a.i, a.j);
+            }
+        }
+
+        stats_.finds = ds.find_count();
+        stats_.unions = ds.union_count();
+    }
+
+    /**
+     * @brief Prim denso con vector de distancias al árbol (sin montículo ni lista de aristas).
+     *
+     * Los puntos aún fuera del árbol se guardan compactados en formato SoA; en
+     * cada paso se extrae el más cercano y se actualizan las distancias del resto
+     * con el núcleo vectorizado, recorriendo la memoria de forma secuencial. El
+     * siguiente más cercano se busca en la misma pasada. Los empates (de padre y
+     * de siguiente punto) se deciden con arc_order, así que el árbol es el mismo
+     * que el de Kruskal.
+     */
+    void point_set::prim(void)
+    {
+        const int n = static_cast<int>(size());
 
-            // a.second es el arco (sin peso)
-            find_incident_subtrees(st, a.second, i, j);
+        emst_.clear();
 
-            // Si no se encuentran índices (i o j = -1), se ignora la arista
-            if (i == -1 || j == -1)
+        if (n == 0)
+        {
+            return;
+        }
+
+        emst_.reserve(n - 1);
+
+        // Puntos fuera del árbol: coordenadas, índice, distancia al árbol y punto del árbol más cercano
+        std::vector<double> xs(n - 1);
+        std::vector<double> ys(n - 1);
+        std::vector<int> index(n - 1);
+        std::vector<double> dist(n - 1);
+        std::vector<int> parent(n - 1, 0);
+        std::vector<double> block(n - 1);
+
+        for (int i = 1; i < n; ++i)
+        {
+            xs[i - 1] = (*this)[i].first;
+            ys[i - 1] = (*this)[i].second;
+            index[i - 1] = i;
+        }
+
+        const CyA::arc_order order(*this);
+
+        // Entre los puntos a la mínima distancia, el de la menor arista (parent, index) en arc_order
+        auto break_tie = [&](int best, int count) {
+            const double d = dist[best];
+            for (int k = 0; k < count; ++k)
+            {
+                if (dist[k] == d && order.before(parent[k], index[k], parent[best], index[best]))
+                {
+                    best = k;
+                }
+            }
+            return best;
+        };
+
+        // El árbol comienza en el punto 0
+        squared_distances(xs.data(), ys.data(), (*this)[0].first, (*this)[0].second, n - 1, dist.data());
+
+        int best = 0;
+        bool tied = false;
+        for (int k = 1; k < n - 1; ++k)
+        {
+            if (dist[k] < dist[best])
+            {
+                best = k;
+                tied = false;
+            }
+            else if (dist[k] == dist[best])
+            {
+                tied = true;
+            }
+        }
+
+        if (tied)
+        {
+            best = break_tie(best, n - 1);
+        }
+
+        for (int remaining = n - 1; remaining > 0; --remaining)
+        {
+            const int v = index[best];
+            const double vx = xs[best];
+            const double vy = ys[best];
+
+            emst_.emplace_back(std::min(parent[best], v), std::max(parent[best], v));
+
+            // Sacarlo del conjunto compactado moviendo el último a su hueco
+            const int last = remaining - 1;
+            xs[best] = xs[last];
+            ys[best] = ys[last];
+            index[best] = index[last];
+            dist[best] = dist[last];
+            parent[best] = parent[last];
+
+            // Actualizar distancias al árbol con el nuevo vértice v y buscar el siguiente
+            squared_distances(xs.data(), ys.data(), vx, vy, last, block.data());
+
+            best = 0;
+            tied = false;
+            bool ties = false;
+            double best_dist = std::numeric_limits<double>::infinity();
+
+            for (int k = 0; k < last; ++k)
+            {
+                double d = dist[k];
+
+                // Los empates son raros: una sola comparación en el caso común
+                if (block[k] <= d)
+                {
+                    if (block[k] < d)
+                    {
+                        d = block[k];
+                        dist[k] = d;
+                        parent[k] = v;
+                    }
+                    else
+                    {
+                        ties = true;
+                    }
+                }
+
+                if (d <= best_dist)
+                {
+                    tied = d == best_dist;
+                    best_dist = d;
+                    best = tied ? best : k;
+                }
+            }
+
+            // A igual distancia el padre es el que da la arista menor en arc_order
+            if (ties)
+            {
+                for (int k = 0; k < last; ++k)
+                {
+                    if (block[k] == dist[k] && parent[k] != v && order.before(v, index[k], parent[k], index[k]))
+                    {
+                        parent[k] = v;
+                    }
+                }
+            }
+
+            if (tied)
+            {
+                best = break_tie(best, last);
+            }
+        }
+    }
+
+    /**
+     * @brief Inserta p y recalcula el EMST a partir del árbol actual y los vecinos de p por sectores.
+     * @param p punto a añadir
+     */
+    void point_set::insert(const CyA::point &p)
+    {
+        const int v = static_cast<int>(size());
+        push_back(p);
+
+        if (v == 0)
+        {
+            emst_.clear();
+            return;
+        }
+
+        // Arcos actuales con su peso (distancia al cuadrado)
+        CyA::index_arc_vector tree_arcs;
+        tree_arcs.reserve(emst_.size());
+
+        for (const CyA::index_arc &a : emst_)
+        {
+            const double dx = (*this)[a.first].first - (*this)[a.second].first;
+            const double dy = (*this)[a.first].second - (*this)[a.second].second;
+
+            tree_arcs.emplace_back(dx * dx + dy * dy, a.first, a.second);
+        }
+
+        // Tras una inserción los arcos quedan ordenados; solo la primera vez hace falta ordenar
+        const CyA::arc_order order(*this);
+        if (!std::is_sorted(tree_arcs.begin(), tree_arcs.end(), order))
+        {
+            std::sort(tree_arcs.begin(), tree_arcs.end(), order);
+        }
+
+        // Punto más cercano a p en cada sector de 60 grados
+        const double sector_angle = std::acos(-1.0) / 3.0;
+        int nearest[6] = {-1, -1, -1, -1, -1, -1};
+        double best[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+        for (int i = 0; i < v; ++i)
+        {
+            const double dx = (*this)[i].first - p.first;
+            const double dy = (*this)[i].second - p.second;
+            const double d = dx * dx + dy * dy;
+
+            int sector = static_cast<int>((std::atan2(dy, dx) + std::acos(-1.0)) / sector_angle);
+            sector = std::min(std::max(sector, 0), 5);
+
+            if (nearest[sector] == -1 || d < best[sector] ||
+                (d == best[sector] && order.before(i, v, nearest[sector], v)))
+            {
+                nearest[sector] = i;
+                best[sector] = d;
+            }
+        }
+
+        CyA::index_arc_vector new_arcs;
+        for (int s = 0; s < 6; ++s)
+        {
+            if (nearest[s] != -1)
+            {
+                new_arcs.emplace_back(best[s], nearest[s], v);
+            }
+        }
+
+        std::sort(new_arcs.begin(), new_arcs.end(), order);
+
+        // Kruskal sobre la mezcla ordenada de ambos conjuntos de aristas
+        CyA::index_arc_vector candidates(tree_arcs.size() + new_arcs.size());
+        std::merge(tree_arcs.begin(), tree_arcs.end(), new_arcs.begin(), new_arcs.end(), candidates.begin(), order);
+
+        kruskal(candidates);
+    }
+
+    /**
+     * @brief Ordena los arcos de emst_ como la salida de la versión original.
+     * @return arcos (i, j), con i < j, en orden de salida
+     */
+    CyA::index_tree point_set::get_output_tree(void) const
+    {
+        const int n = static_cast<int>(size());
+        const std::size_t m = emst_.size();
+
+        // Orden de aceptación original: (distancia, punto menor, punto mayor)
+        std::vector<double> weight(m);
+        for (std::size_t k = 0; k < m; ++k)
+        {
+            weight[k] = euclidean_distance(emst_[k]);
+        }
+
+        auto low = [this](const CyA::index_arc &a) { return std::min(a.first, a.second); };
+        auto high = [this](const CyA::index_arc &a) { return std::max(a.first, a.second); };
+
+        std::vector<std::uint32_t> order(m);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b)
+                  {
+                      if (weight[a] != weight[b])
+                      {
+                          return weight[a] < weight[b];
+                      }
+                      const CyA::point &pa = (*this)[low(emst_[a])];
+                      const CyA::point &pb = (*this)[low(emst_[b])];
+                      if (pa != pb)
+                      {
+                          return pa < pb;
+                      }
+                      return (*this)[high(emst_[a])] < (*this)[high(emst_[b])];
+                  });
+
+        // Árbol de fusiones: el arco k une los nodos left[k] (sub-árbol con el punto
+        // de menor índice) y right[k]; -1 es un punto aislado
+        disjoint_set ds(n);
+        std::vector<int> node(n, -1);
+        std::vector<int> slot(n);
+        std::iota(slot.begin(), slot.end(), 0);
+        std::vector<int> left(m, -1);
+        std::vector<int> right(m, -1);
+
+        for (std::uint32_t k : order)
+        {
+            const int a = ds.find(static_cast<int>(emst_[k].first));
+            const int b = ds.find(static_cast<int>(emst_[k].second));
+            if (a == b)
+            {
+                continue;
+            }
+
+            const bool a_first = slot[a] < slot[b];
+            left[k] = node[a_first ? a : b];
+            right[k] = node[a_first ? b : a];
+
+            const int first_slot = std::min(slot[a], slot[b]);
+            ds.unite(a, b);
+
+            const int r = ds.find(a);
+            node[r] = static_cast<int>(k);
+            slot[r] = first_slot;
+        }
+
+        // Recorrido en postorden (left, right, arco) de cada componente por su punto menor
+        CyA::index_tree tree;
+        tree.reserve(m);
+        std::vector<int> stack;
+
+        for (int p = 0; p < n; ++p)
+        {
+            const int r = ds.find(p);
+            if (slot[r] != p || node[r] < 0)
             {
                 continue;
             }
 
-            // Si pertenecen a sub-árboles distintos, se fusionan
-            if (i != j)
+            stack.push_back(node[r]);
+            while (!stack.empty())
             {
-                merge_subtrees(st, a.second, i, j, a.first);
+                const int v = stack.back();
+                stack.pop_back();
+
+                if (v < 0)
+                {
+                    // ~k: todos los arcos de sus hijos ya están escritos
+                    tree.emplace_back(low(emst_[~v]), high(emst_[~v]));
+                    continue;
+                }
+
+                stack.push_back(~v);
+                if (right[v] >= 0)
+                {
+                    stack.push_back(right[v]);
+                }
+                if (left[v] >= 0)
+                {
+                    stack.push_back(left[v]);
+                }
             }
         }
 
-        // Tras las fusiones, si existe un único componente se guarda su lista de arcos en emst_
-        if (!st.empty())
+        return tree;
+    }
+
+    /**
+     * @brief Construye la vista de compatibilidad con las coordenadas de cada arco.
+     * @return vector de arcos que forman el EMST
+     */
+    CyA::tree point_set::get_tree(void) const
+    {
+        CyA::tree t;
+        t.reserve(emst_.size());
+
+        for (const CyA::index_arc &a : get_output_tree())
         {
-            emst_ = st[0].get_arcs();
+            t.push_back(std::make_pair((*this)[a.first], (*this)[a.second]));
+        }
+
+        return t;
+    }
+
+    /**
+     * @brief Reconstruye el bosque de sub_trees fusionando en el orden en que se aceptaron los arcos.
+     * @param st bosque a rellenar (un sub_tree por componente)
+     * @param resource recurso de memoria de los puntos de todos los sub_trees
+     */
+    void point_set::build_forest(forest &st, std::pmr::memory_resource *resource) const
+    {
+        const int n = static_cast<int>(size());
+
+        st.clear();
+        st.reserve(n);
+
+        // Posición en st del sub-árbol de cada representante y viceversa
+        std::vector<int> slot_of_root(n);
+        std::vector<int> root_of_slot(n);
+
+        // Cada punto comienza como un sub-árbol aislado
+        for (int i = 0; i < n; ++i)
+        {
+            st.emplace_back(resource);
+            st.back().add_point((*this)[i]); // sub-árbol con un solo vértice
+
+            slot_of_root[i] = i;
+            root_of_slot[i] = i;
+        }
+
+        disjoint_set ds(n);
+
+        for (const CyA::index_arc &ia : emst_)
+        {
+            const int i = slot_of_root[ds.find(ia.first)];
+            const int j = slot_of_root[ds.find(ia.second)];
+
+            const CyA::arc a = std::make_pair((*this)[ia.first], (*this)[ia.second]);
+            merge_subtrees(st, a, i, j, euclidean_distance(a));
+
+            // merge_subtrees conserva el índice menor y mueve el último al hueco del mayor
+            const int kept = std::min(i, j);
+            const int removed = std::max(i, j);
+            const int last = static_cast<int>(root_of_slot.size()) - 1;
+
+            ds.unite(ia.first, ia.second);
+            root_of_slot[removed] = root_of_slot[last];
+            slot_of_root[root_of_slot[removed]] = removed;
+            root_of_slot.pop_back();
+
+            root_of_slot[kept] = ds.find(ia.first);
+            slot_of_root[root_of_slot[kept]] = kept;
         }
     }
 
@@ -207,7 +1376,7 @@ namespace EMST
         double sum = 0.0;
 
         // Sumar la distancia euclídea de cada arco del EMST
-        for (const CyA::arc &a : emst_)
+        for (const CyA::index_arc &a : emst_)
         {
             sum += euclidean_distance(a);
         }
@@ -222,8 +1391,10 @@ namespace EMST
     void point_set::write_tree(std::ostream &os) const
     {
         // Imprime cada arco en formato: (x, y) -> (x2, y2)
-        for (const CyA::arc &a : emst_)
+        for (const CyA::index_arc &ia : get_output_tree())
         {
+            const CyA::arc a = std::make_pair((*this)[ia.first], (*this)[ia.second]);
+
             os << "(";
             os << std::setw(MAX_SZ) << std::fixed << std::setprecision(MAX_PREC) << a.first.first << ", "
                << std::setw(MAX_SZ) << std::fixed << std::setprecision(MAX_PREC) << a.first.second;
@@ -237,6 +1408,15 @@ namespace EMST
         os << std::fixed << std::setprecision(2) << compute_cost() << std::endl;
     }
 
+    /**
+     * @brief Escribe el EMST con output_writer (mismo formato que write_tree(ostream&)).
+     * @param out destino
+     */
+    void point_set::write_tree(output_writer &out) const
+    {
+        EMST::write_tree(out, *this, get_output_tree(), compute_cost());
+    }
+
     /**
      * @brief Escribe el conjunto de puntos (invoca operador<<).
      * @param os flujo de salida
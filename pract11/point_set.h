@@ -2,6 +2,11 @@
  * @file point_set.h
  * @author Daniel Palenzuela Álvarez alu0101140469
  * @brief Declaración de la clase point_set que implementa EMST por Kruskal.
+ *
+ * El motor (engine) decide cómo se obtiene el árbol: Kruskal sobre todas las
+ * parejas de puntos (ordenación completa o Filter-Kruskal), Kruskal sobre las
+ * aristas de la triangulación de Delaunay, Borůvka dual sobre un kd-tree o
+ * Prim denso (estos dos últimos sin lista de aristas).
  */
 
 #pragma once
@@ -9,14 +14,54 @@
 #include <vector>
 #include <string>
 #include <ostream>
+#include <utility>
 
 #include "point_types.h"
 #include "sub_tree.h"
+#include "disjoint_set.h"
+#include "output_writer.h"
+#include "emst_stats.h"
+#include "dendrogram.h"
+
+// Por debajo de este número de aristas Filter-Kruskal ordena el rango completo
+#define FILTER_KRUSKAL_THRESHOLD 1024
+
+// Número de distancias que calcula el núcleo vectorizado en cada llamada
+#define DISTANCE_BLOCK 256
 
 namespace EMST
 {
     typedef std::vector<sub_tree> forest;
 
+    class tile_workers;
+
+    /**
+     * @brief Motores disponibles para calcular el EMST.
+     */
+    enum class engine
+    {
+        kruskal,  ///< Kruskal sobre todas las parejas de puntos (O(n^2) aristas)
+        delaunay, ///< Kruskal sobre las aristas de la triangulación de Delaunay (O(n))
+        boruvka,  ///< Borůvka dual-tree sobre un kd-tree (memoria O(n))
+        filter,   ///< Filter-Kruskal sobre todas las parejas (ordenación parcial)
+        prim      ///< Prim denso: O(n^2) tiempo, O(n) memoria
+    };
+
+    /**
+     * @brief Convierte un nombre de motor ("kruskal", "delaunay", "boruvka", "filter", "prim") en su valor.
+     * @param name nombre del motor
+     * @param e motor reconocido (salida)
+     * @return true si el nombre es válido
+     */
+    bool parse_engine(const std::string &name, engine &e);
+
+    /**
+     * @brief Nombre de un motor (inverso de parse_engine).
+     * @param e motor
+     * @return nombre
+     */
+    const char *engine_name(engine e);
+
     /**
      * @class point_set
      * @brief Conjunto de puntos con la capacidad de calcular su EMST (Kruskal adaptado).
@@ -26,7 +71,10 @@ namespace EMST
     class point_set : public CyA::point_vector
     {
     private:
-        CyA::tree emst_;
+        CyA::index_tree emst_;
+        CyA::index_arc_vector arcs_;
+        int threads_;
+        emst_stats stats_;
 
     public:
         /**
@@ -35,15 +83,116 @@ namespace EMST
          */
         explicit point_set(const CyA::point_vector &points);
 
+        /**
+         * @brief Construye un point_set tomando posesión del vector de puntos (sin copiarlo).
+         * @param points vector de puntos inicial
+         */
+        explicit point_set(CyA::point_vector &&points);
+
         /**
          * @brief Destructor.
          */
         ~point_set(void);
 
+        /**
+         * @brief Sustituye el conjunto de puntos reutilizando los búferes internos.
+         *
+         * Permite resolver muchos conjuntos con el mismo objeto sin volver a
+         * reservar el vector de aristas candidatas.
+         * @param points nuevo vector de puntos
+         */
+        void reset(CyA::point_vector &&points);
+
         /**
          * @brief Ejecuta el algoritmo EMST (Kruskal) y guarda el árbol en emst_.
+         *
+         * Antes del motor se colapsan los puntos con coordenadas idénticas: el
+         * motor trabaja solo con los distintos y cada repetido se une con una
+         * arista de peso 0 a su primera aparición (esas aristas van primero).
+         * Así todos los motores dan el mismo árbol con n-1 aristas sea cual sea
+         * el número de repetidos.
+         * @param e motor que genera las aristas candidatas
+         */
+        void EMST(engine e = engine::kruskal);
+
+        /**
+         * @brief Kruskal externo sobre todas las parejas con memoria acotada.
+         *
+         * Las aristas se generan en bloques de budget bytes que se ordenan y se
+         * escriben como tramos en un fichero temporal de dir; después se mezclan
+         * desde disco y la lectura se detiene al aceptar n-1 aristas. Si todas
+         * caben en el presupuesto no se escribe nada.
+         * @param budget memoria para las aristas (bytes)
+         * @param dir directorio de los ficheros temporales
+         * @param error mensaje de error de E/S (salida)
+         * @return false si falla la escritura o la lectura de los tramos
+         */
+        bool EMST_external(std::size_t budget, const std::string &dir, std::string &error);
+
+        /**
+         * @brief EMST exacto repartido entre procesos trabajadores por franjas verticales.
+         *
+         * Los puntos se dividen en tiles franjas con el mismo número de puntos
+         * (al menos TILE_MIN_POINTS) y cada trabajador calcula el EMST de una
+         * franja. Los árboles locales y una arista entre cada par de franjas
+         * vecinas forman un árbol generador: ninguna arista del EMST entre las
+         * franjas i y j es más larga que la mayor arista r_ij del camino entre
+         * ellas en ese árbol. Una arista del EMST está además en el EMST de
+         * cualquier subconjunto que contenga sus extremos, así que basta con el
+         * EMST de cada par de franjas a distancia <= r_ij, limitado a la banda de
+         * anchura r_ij junto a la otra franja. Kruskal sobre las aristas locales
+         * y las que cruzan franjas da el mismo coste que EMST().
+         * @param tiles número de franjas
+         * @param workers trabajadores ya lanzados (con el motor de cada franja)
+         * @param error mensaje de error (salida)
+         * @return false si falla algún trabajador
+         */
+        bool EMST_tiled(int tiles, tile_workers &workers, std::string &error);
+
+        /**
+         * @brief Árbol aproximado de coste como mucho (1 + epsilon) veces el EMST.
+         *
+         * Kruskal sobre las aristas de una descomposición en pares bien separados
+         * (un (1 + epsilon)-spanner con O(n / epsilon²) aristas).
+         * @param epsilon error relativo admitido (> 0)
+         */
+        void EMST_approx(double epsilon);
+
+        /**
+         * @brief Añade un punto y actualiza el EMST sin recalcularlo desde cero.
+         *
+         * Requiere que emst_ sea el EMST de los puntos anteriores (tras EMST() o
+         * tras inserciones sucesivas desde un conjunto vacío). Las únicas aristas
+         * nuevas que pueden entrar en el árbol unen p con el punto más cercano de
+         * cada uno de los 6 sectores de 60 grados a su alrededor, así que basta
+         * con Kruskal sobre los n-1 arcos actuales más esas 6 aristas: O(n)
+         * por inserción (los arcos ya quedan ordenados por peso).
+         * @param p punto a añadir
+         */
+        void insert(const CyA::point &p);
+
+        /**
+         * @brief Sustituye el árbol por uno ya calculado (p. ej. leído de la caché de resultados).
+         * @param tree aristas (i, j) del EMST de estos puntos
+         */
+        inline void set_index_tree(CyA::index_tree &&tree) { emst_ = std::move(tree); }
+
+        /**
+         * @brief Fija el número de hilos para generar y ordenar las aristas.
+         * @param threads número de hilos (mínimo 1)
+         */
+        inline void set_threads(int threads) { threads_ = threads > 1 ? threads : 1; }
+
+        /**
+         * @brief Materializa el EMST calculado como bosque de sub_trees (uno por componente).
+         *
+         * Con un recurso de memoria propio (p. ej. std::pmr::unsynchronized_pool_resource,
+         * que debe vivir más que st) los nodos de puntos salen de un mismo pool y las
+         * fusiones los trasladan sin reservas nuevas.
+         * @param st bosque a rellenar
+         * @param resource recurso de memoria de los puntos de los sub_trees
          */
-        void EMST(void);
+        void build_forest(forest &st, std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const;
 
         /**
          * @brief Escribe el árbol (lista de arcos) en el flujo dado.
@@ -51,6 +200,12 @@ namespace EMST
          */
         void write_tree(std::ostream &os) const;
 
+        /**
+         * @brief Escribe el árbol (lista de arcos) y su coste con la salida con búfer.
+         * @param out destino
+         */
+        void write_tree(output_writer &out) const;
+
         /**
          * @brief Escribe el conjunto de puntos en el flujo dado (uso auxiliar).
          * @param os flujo de salida
@@ -58,10 +213,29 @@ namespace EMST
         void write(std::ostream &os) const;
 
         /**
-         * @brief Devuelve el árbol (EMST) calculado.
-         * @return referencia constante al vector de arcos que forman el EMST
+         * @brief Devuelve el árbol (EMST) calculado con las coordenadas de cada arco.
+         *
+         * Vista de compatibilidad construida a partir de get_output_tree().
+         * @return vector de arcos que forman el EMST
          */
-        inline const CyA::tree& get_tree(void) const { return emst_; }
+        CyA::tree get_tree(void) const;
+
+        /**
+         * @brief Devuelve el árbol (EMST) calculado como pares de índices de puntos.
+         * @return referencia constante al vector de arcos (i, j)
+         */
+        inline const CyA::index_tree& get_index_tree(void) const { return emst_; }
+
+        /**
+         * @brief Devuelve el árbol con los arcos en el orden de salida de la versión original.
+         *
+         * Los arcos de emst_ se ordenan como en la versión original (distancia y
+         * coordenadas) y se repiten sus fusiones de sub_trees. El sub-árbol con el
+         * punto de menor índice absorbe al otro y sus arcos van primero. Así
+         * write_tree y get_tree no dependen del motor.
+         * @return arcos (i, j), con i < j, en orden de salida
+         */
+        CyA::index_tree get_output_tree(void) const;
 
         /**
          * @brief Devuelve los puntos originales.
@@ -75,24 +249,96 @@ namespace EMST
          */
         inline const double get_cost(void) const { return compute_cost(); }
 
+        /**
+         * @brief Devuelve las medidas por fase de la última llamada a EMST().
+         * @return referencia constante a las medidas
+         */
+        inline const emst_stats& get_stats(void) const { return stats_; }
+
+        /**
+         * @brief Dendrograma de enlace simple del EMST calculado (ordena sus n-1 aristas).
+         * @return dendrograma con las consultas de corte por umbral y por número de clusters
+         */
+        inline dendrogram get_dendrogram(void) const { return dendrogram(*this, emst_); }
+
     private:
         /**
-         * @brief Calcula el vector de aristas ponderadas (todas las parejas de puntos).
-         * @param av vector a rellenar con pares (peso, arco)
+         * @brief Calcula el vector de aristas ponderadas (todas las parejas de puntos, sin ordenar).
+         * @param av vector a rellenar con aristas (distancia al cuadrado, i, j) con i, j índices de puntos
          */
-        void compute_arc_vector(CyA::arc_vector &av) const;
+        void compute_arc_vector(CyA::index_arc_vector &av) const;
 
         /**
-         * @brief Encuentra los índices i, j en el bosque st donde están los extremos del arco a.
-         * @param st bosque actual
-         * @param a arco (sin peso) cuyos extremos vamos a localizar
-         * @param i índice del sub-árbol que contiene a.first (salida)
-         * @param j índice del sub-árbol que contiene a.second (salida)
+         * @brief Genera en su posición de av las aristas de las filas [first, last).
+         * @param av vector ya dimensionado con todas las aristas
+         * @param xs coordenadas x de todos los puntos (SoA)
+         * @param ys coordenadas y de todos los puntos (SoA)
+         * @param first primera fila
+         * @param last fila siguiente a la última
          */
-        void find_incident_subtrees(const forest& st, const CyA::arc &a, int& i, int& j) const;
+        void compute_arc_rows(CyA::index_arc_vector &av,
+                              const std::vector<double> &xs,
+                              const std::vector<double> &ys,
+                              int first, int last) const;
+
+        /**
+         * @brief Calcula las aristas de la triangulación de Delaunay (sin ordenar).
+         * @param av vector a rellenar con aristas (distancia al cuadrado, i, j)
+         */
+        void compute_delaunay_arc_vector(CyA::index_arc_vector &av) const;
+
+        /**
+         * @brief Genera las aristas de la fila i a partir de la columna j, hasta llenar av.
+         * @param av vector de aristas (se añaden al final sin superar su capacidad)
+         * @param xs coordenadas x de todos los puntos (SoA)
+         * @param ys coordenadas y de todos los puntos (SoA)
+         * @param i fila actual (se avanza)
+         * @param j primera columna pendiente de la fila (se avanza)
+         */
+        void fill_arc_block(CyA::index_arc_vector &av,
+                            const std::vector<double> &xs,
+                            const std::vector<double> &ys,
+                            int &i, int &j) const;
+
+        /**
+         * @brief Recorre las aristas ordenadas y guarda en emst_ las que unen componentes distintas.
+         * @param av aristas candidatas ordenadas por peso creciente
+         */
+        void kruskal(const CyA::index_arc_vector &av);
+
+        /**
+         * @brief Filter-Kruskal recursivo sobre el rango [begin, end) de aristas sin ordenar.
+         * @param begin inicio del rango
+         * @param end fin del rango
+         * @param ds componentes actuales (se modifica)
+         */
+        void filter_kruskal(CyA::index_arc_vector::iterator begin,
+                            CyA::index_arc_vector::iterator end,
+                            disjoint_set &ds);
+
+        /**
+         * @brief Prim denso sobre el vector de distancias al árbol; guarda el árbol en emst_.
+         */
+        void prim(void);
+
+        /**
+         * @brief Ejecuta el motor sobre los puntos tal cual (sin colapsar repetidos).
+         * @param e motor
+         */
+        void solve(engine e);
+
+        /**
+         * @brief Busca los puntos repetidos ordenando los índices por coordenadas.
+         * @param first_of primera aparición de cada punto (él mismo si no se repite)
+         * @return número de puntos repetidos
+         */
+        std::size_t find_duplicates(std::vector<std::uint32_t> &first_of) const;
 
         /**
          * @brief Fusiona en st los sub-árboles i y j usando el arco a (y su peso).
+         *
+         * El resultado queda en el índice menor y el último sub-árbol de st pasa
+         * a ocupar el mayor: O(1), sin desplazar el resto del vector.
          * @param st bosque (se modifica)
          * @param a arco que une los subárboles
          * @param i índice del primer sub-árbol
@@ -113,5 +359,12 @@ namespace EMST
          * @return distancia euclídea (double)
          */
         double euclidean_distance(const CyA::arc& a) const;
+
+        /**
+         * @brief Calcula la distancia euclídea entre los puntos de índices a.first y a.second.
+         * @param a arco con dos índices de puntos
+         * @return distancia euclídea (double)
+         */
+        double euclidean_distance(const CyA::index_arc& a) const;
     };
 }
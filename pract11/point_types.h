@@ -4,11 +4,15 @@
  * @brief Tipos básicos para la práctica EMST (puntos, arcos, vectores...).
  *
  * Define tipos (point, arc, weigthed_arc, colecciones) y operadores de
- * entrada/salida para puntos y vectores de puntos.
+ * entrada/salida para puntos y vectores de puntos. Los tipos index_* son la
+ * representación interna de los motores: referencian los puntos por su índice
+ * en el point_vector en lugar de copiar sus coordenadas; tree se mantiene
+ * como vista de compatibilidad.
  */
 
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -31,6 +35,109 @@ namespace CyA
     typedef std::set<point> point_collection;
 
     typedef std::vector<arc> tree;
+
+    typedef std::pair<std::uint32_t, std::uint32_t> index_arc;
+
+    /**
+     * @brief Arista ponderada compacta: peso e índices de sus extremos (16 bytes
+     *        con peso double frente a los 40 de weigthed_arc, 12 con peso float).
+     *        operator< ordena por (weight, i, j); los motores de point_set usan
+     *        arc_order, que desempata por coordenadas como la versión original.
+     *
+     * Los motores guardan como peso la distancia al cuadrado; la raíz solo se
+     * calcula para las n-1 aristas aceptadas (compute_cost / salida).
+     */
+    template <class W>
+    struct basic_weighted_index_arc
+    {
+        W weight;
+        std::uint32_t i;
+        std::uint32_t j;
+
+        basic_weighted_index_arc(void) = default;
+
+        basic_weighted_index_arc(W w, std::uint32_t a, std::uint32_t b) : weight(w), i(a), j(b) {}
+
+        inline bool operator<(const basic_weighted_index_arc &other) const
+        {
+            if (weight != other.weight)
+            {
+                return weight < other.weight;
+            }
+
+            return i != other.i ? i < other.i : j < other.j;
+        }
+    };
+
+    typedef basic_weighted_index_arc<double> weighted_index_arc;
+    typedef std::vector<weighted_index_arc> index_arc_vector;
+
+    // Modo de precisión simple (--float): coordenadas y pesos float
+    typedef basic_weighted_index_arc<float> weighted_index_arc_f;
+    typedef std::vector<weighted_index_arc_f> index_arc_vector_f;
+
+    typedef std::vector<index_arc> index_tree;
+
+    /**
+     * @class arc_order
+     * @brief Orden total de la versión original: (peso, p_i, p_j) con i < j.
+     *
+     * A igual peso decide el extremo de menor índice comparando coordenadas y
+     * después el otro (el índice solo decide entre puntos repetidos). Con un
+     * orden total el EMST es único, así que todos los motores que lo usan
+     * devuelven el mismo árbol aunque haya distancias empatadas.
+     */
+    class arc_order
+    {
+    private:
+        const point_vector *points_;
+
+    public:
+        explicit arc_order(const point_vector &points) : points_(&points) {}
+
+        /**
+         * @brief Compara dos aristas del mismo peso por sus extremos.
+         * @return true si (ai, aj) va antes que (bi, bj)
+         */
+        inline bool before(std::uint32_t ai, std::uint32_t aj, std::uint32_t bi, std::uint32_t bj) const
+        {
+            if (aj < ai)
+            {
+                std::swap(ai, aj);
+            }
+            if (bj < bi)
+            {
+                std::swap(bi, bj);
+            }
+
+            const point &pa = (*points_)[ai];
+            const point &pb = (*points_)[bi];
+            if (pa != pb)
+            {
+                return pa < pb;
+            }
+
+            const point &qa = (*points_)[aj];
+            const point &qb = (*points_)[bj];
+            if (qa != qb)
+            {
+                return qa < qb;
+            }
+
+            return ai != bi ? ai < bi : aj < bj;
+        }
+
+        template <class W>
+        inline bool operator()(const basic_weighted_index_arc<W> &a, const basic_weighted_index_arc<W> &b) const
+        {
+            if (a.weight != b.weight)
+            {
+                return a.weight < b.weight;
+            }
+
+            return before(a.i, a.j, b.i, b.j);
+        }
+    };
 }
 
 /**
@@ -0,0 +1,370 @@
+/**
+ * @file result_cache.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de la caché de resultados.
+ */
+
+#include "result_cache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace EMST
+{
+    namespace
+    {
+        /**
+         * @brief Cabecera de una entrada (48 bytes) seguida de las opciones, las
+         *        coordenadas (2 x double por punto) y las aristas (2 x uint32).
+         */
+        struct entry_header
+        {
+            char magic[8];         // "EMSTRES\0"
+            std::uint32_t version; // RESULT_CACHE_VERSION
+            std::uint32_t options; // longitud de la cadena de opciones
+            std::uint64_t key;     // clave (comprobación frente a nombres cambiados)
+            std::uint64_t points;  // número de puntos
+            std::uint64_t edges;   // número de aristas
+            double cost;
+        };
+
+        const std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+        const std::uint64_t FNV_PRIME = 1099511628211ull;
+
+        /**
+         * @brief Finalizador de MurmurHash3: cada bit de la entrada afecta a todos los de la salida.
+         */
+        std::uint64_t fmix64(std::uint64_t h)
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+
+            return h;
+        }
+
+        /**
+         * @brief Mezcla length bytes en h: cada palabra de 8 bytes se mezcla antes
+         *        de combinarla y la rotación lleva los bits altos al producto.
+         */
+        std::uint64_t mix_bytes(std::uint64_t h, const unsigned char *data, std::size_t length)
+        {
+            std::size_t k = 0;
+
+            for (; k + 8 <= length; k += 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, data + k, 8);
+                h ^= fmix64(word);
+                h = ((h << 31) | (h >> 33)) * FNV_PRIME;
+            }
+
+            for (; k < length; ++k)
+            {
+                h = (h ^ data[k]) * FNV_PRIME;
+            }
+
+            return h;
+        }
+
+        /**
+         * @brief Lee exactamente length bytes.
+         */
+        bool read_all(int fd, void *data, std::size_t length)
+        {
+            char *p = static_cast<char *>(data);
+
+            while (length > 0)
+            {
+                const ssize_t r = ::read(fd, p, length);
+                if (r < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (r <= 0)
+                {
+                    return false;
+                }
+
+                p += r;
+                length -= static_cast<std::size_t>(r);
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Escribe exactamente length bytes.
+         */
+        bool write_all(int fd, const void *data, std::size_t length)
+        {
+            const char *p = static_cast<const char *>(data);
+
+            while (length > 0)
+            {
+                const ssize_t w = ::write(fd, p, length);
+                if (w < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (w < 0)
+                {
+                    return false;
+                }
+
+                p += w;
+                length -= static_cast<std::size_t>(w);
+            }
+
+            return true;
+        }
+    }
+
+    /**
+     * @brief Constructor.
+     * @param dir directorio de la caché
+     * @param max_bytes tamaño máximo
+     */
+    result_cache::result_cache(const std::string &dir, std::uint64_t max_bytes) : dir_(dir),
+                                                                                  max_bytes_(max_bytes)
+    {
+    }
+
+    /**
+     * @brief Destructor vacío.
+     */
+    result_cache::~result_cache(void)
+    {
+    }
+
+    /**
+     * @brief Hash de las coordenadas (tal como están en memoria) y de las opciones.
+     *
+     * Solo elige el fichero: lookup() compara además las opciones y las coordenadas guardadas.
+     * @param points puntos
+     * @param options opciones del motor
+     * @return clave
+     */
+    std::uint64_t result_cache::key(const CyA::point_vector &points, const std::string &options)
+    {
+        std::uint64_t h = FNV_OFFSET;
+
+        const std::uint64_t n = points.size();
+        h = mix_bytes(h, reinterpret_cast<const unsigned char *>(&n), sizeof(n));
+        h = mix_bytes(h, reinterpret_cast<const unsigned char *>(points.data()), points.size() * sizeof(CyA::point));
+        h = mix_bytes(h, reinterpret_cast<const unsigned char *>(options.data()), options.size());
+
+        return fmix64(h ^ options.size());
+    }
+
+    /**
+     * @brief Ruta "dir/<16 dígitos hexadecimales>.emst".
+     * @param key clave
+     * @return ruta
+     */
+    std::string result_cache::path(std::uint64_t key) const
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.emst", static_cast<unsigned long long>(key));
+
+        return dir_ + "/" + name;
+    }
+
+    /**
+     * @brief Lee la entrada y comprueba firma, clave, opciones, coordenadas y aristas.
+     * @return true si la entrada es válida y corresponde exactamente a estos puntos
+     */
+    bool result_cache::lookup(std::uint64_t key, const CyA::point_vector &points, const std::string &options,
+                              CyA::index_tree &tree, double &cost) const
+    {
+        const std::uint64_t n = points.size();
+        const std::string file = path(key);
+        const int fd = ::open(file.c_str(), O_RDONLY);
+
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        entry_header h;
+        bool ok = read_all(fd, &h, sizeof(h)) &&
+                  std::memcmp(h.magic, RESULT_CACHE_MAGIC, sizeof(RESULT_CACHE_MAGIC)) == 0 &&
+                  h.version == RESULT_CACHE_VERSION && h.key == key && h.points == n &&
+                  h.options == options.size() && h.edges < (n > 0 ? n : 1);
+
+        // Misma clave no basta: opciones y coordenadas deben coincidir byte a byte
+        if (ok)
+        {
+            std::string stored_options(options.size(), '\0');
+            CyA::point_vector stored_points(points.size());
+
+            ok = read_all(fd, &stored_options[0], stored_options.size()) && stored_options == options &&
+                 read_all(fd, static_cast<void *>(stored_points.data()), n * sizeof(CyA::point)) &&
+                 std::memcmp(stored_points.data(), points.data(), n * sizeof(CyA::point)) == 0;
+        }
+
+        if (ok)
+        {
+            std::vector<std::uint32_t> data(2 * h.edges);
+            ok = read_all(fd, data.data(), data.size() * sizeof(std::uint32_t));
+
+            // Una entrada dañada no puede dar índices fuera del conjunto
+            for (std::size_t k = 0; ok && k < data.size(); ++k)
+            {
+                ok = data[k] < n;
+            }
+
+            if (ok)
+            {
+                tree.clear();
+                tree.reserve(h.edges);
+                for (std::uint64_t e = 0; e < h.edges; ++e)
+                {
+                    tree.emplace_back(data[2 * e], data[2 * e + 1]);
+                }
+                cost = h.cost;
+            }
+        }
+
+        ::close(fd);
+
+        // Acierto: actualizar mtime para que la expulsión conserve las entradas usadas
+        if (ok)
+        {
+            utimensat(AT_FDCWD, file.c_str(), nullptr, 0);
+        }
+
+        return ok;
+    }
+
+    /**
+     * @brief Escribe un temporal, lo publica con rename y aplica la expulsión.
+     * @return false si falla la escritura
+     */
+    bool result_cache::store(std::uint64_t key, const CyA::point_vector &points, const std::string &options,
+                             const CyA::index_tree &tree, double cost, std::string &error) const
+    {
+        std::string temp = dir_ + "/.tmp-XXXXXX";
+        const int fd = mkstemp(&temp[0]);
+
+        if (fd < 0)
+        {
+            error = dir_ + ": " + std::strerror(errno);
+            return false;
+        }
+
+        entry_header h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, RESULT_CACHE_MAGIC, sizeof(RESULT_CACHE_MAGIC));
+        h.version = RESULT_CACHE_VERSION;
+        h.options = static_cast<std::uint32_t>(options.size());
+        h.key = key;
+        h.points = points.size();
+        h.edges = tree.size();
+        h.cost = cost;
+
+        std::vector<std::uint32_t> data;
+        data.reserve(2 * tree.size());
+        for (const CyA::index_arc &a : tree)
+        {
+            data.push_back(a.first);
+            data.push_back(a.second);
+        }
+
+        const bool written = write_all(fd, &h, sizeof(h)) &&
+                             write_all(fd, options.data(), options.size()) &&
+                             write_all(fd, points.data(), points.size() * sizeof(CyA::point)) &&
+                             write_all(fd, data.data(), data.size() * sizeof(std::uint32_t));
+        const bool closed = ::close(fd) == 0;
+
+        if (!written || !closed || std::rename(temp.c_str(), path(key).c_str()) != 0)
+        {
+            error = temp + ": " + std::strerror(errno);
+            ::unlink(temp.c_str());
+            return false;
+        }
+
+        evict();
+        return true;
+    }
+
+    /**
+     * @brief Con el cerrojo exclusivo, borra las entradas más antiguas mientras se supere el tamaño.
+     */
+    void result_cache::evict(void) const
+    {
+        const std::string lock = dir_ + "/.lock";
+        const int lock_fd = ::open(lock.c_str(), O_RDWR | O_CREAT, 0644);
+
+        if (lock_fd < 0)
+        {
+            return;
+        }
+
+        if (flock(lock_fd, LOCK_EX) != 0)
+        {
+            ::close(lock_fd);
+            return;
+        }
+
+        // Entradas: (mtime, tamaño, nombre)
+        std::vector<std::pair<std::pair<long long, long long>, std::string>> entries;
+        std::uint64_t total = 0;
+
+        DIR *dir = opendir(dir_.c_str());
+        if (dir != nullptr)
+        {
+            for (struct dirent *entry = readdir(dir); entry != nullptr; entry = readdir(dir))
+            {
+                const std::string name(entry->d_name);
+                if (name.size() < 5 || name.compare(name.size() - 5, 5, ".emst") != 0)
+                {
+                    continue;
+                }
+
+                struct stat st;
+                const std::string file = dir_ + "/" + name;
+                if (stat(file.c_str(), &st) == 0)
+                {
+                    const long long mtime = static_cast<long long>(st.st_mtim.tv_sec) * 1000000000ll + st.st_mtim.tv_nsec;
+                    entries.emplace_back(std::make_pair(mtime, static_cast<long long>(st.st_size)), file);
+                    total += static_cast<std::uint64_t>(st.st_size);
+                }
+            }
+            closedir(dir);
+        }
+
+        if (total > max_bytes_)
+        {
+            std::sort(entries.begin(), entries.end());
+
+            for (const auto &e : entries)
+            {
+                if (total <= max_bytes_)
+                {
+                    break;
+                }
+
+                if (::unlink(e.second.c_str()) == 0)
+                {
+                    total -= static_cast<std::uint64_t>(e.first.second);
+                }
+            }
+        }
+
+        flock(lock_fd, LOCK_UN);
+        ::close(lock_fd);
+    }
+}
@@ -0,0 +1,96 @@
+/**
+ * @file result_cache.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Caché en disco de resultados EMST direccionada por contenido.
+ *
+ * Cada entrada es un fichero <clave>.emst con las opciones del motor, las
+ * coordenadas, el árbol (pares de índices) y su coste; la clave es un hash de
+ * 64 bits de las coordenadas leídas y de las opciones, y solo se acepta una
+ * entrada si sus opciones y coordenadas coinciden exactamente con las pedidas. Las entradas se escriben en un temporal del mismo
+ * directorio y se publican con rename(), que es atómico: un lector ve la
+ * entrada completa o no la ve. La expulsión (las entradas con mtime más
+ * antiguo, que se actualiza en cada acierto) se hace con un flock exclusivo
+ * sobre el fichero .lock para que varios procesos no borren a la vez.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "point_types.h"
+
+#define RESULT_CACHE_MAGIC "EMSTRES"
+#define RESULT_CACHE_VERSION 3 // 3: árboles con el desempate de arc_order
+#define RESULT_CACHE_DEFAULT_MIB 256
+
+namespace EMST
+{
+    /**
+     * @class result_cache
+     * @brief Directorio de resultados con tamaño máximo.
+     */
+    class result_cache
+    {
+    private:
+        std::string dir_;
+        std::uint64_t max_bytes_;
+
+    public:
+        /**
+         * @brief Usa el directorio dir (debe existir) con un tamaño máximo.
+         * @param dir directorio de la caché
+         * @param max_bytes tamaño total máximo de las entradas
+         */
+        result_cache(const std::string &dir, std::uint64_t max_bytes);
+
+        /**
+         * @brief Destructor.
+         */
+        ~result_cache(void);
+
+        /**
+         * @brief Clave de un conjunto de puntos y unas opciones (palabras de 64 bits mezcladas con fmix64).
+         * @param points puntos leídos
+         * @param options descripción del motor y sus parámetros
+         * @return clave de 64 bits
+         */
+        static std::uint64_t key(const CyA::point_vector &points, const std::string &options);
+
+        /**
+         * @brief Busca la entrada de la clave y, si es válida, carga su árbol.
+         * @param key clave
+         * @param points puntos (deben coincidir con los guardados)
+         * @param options opciones del motor (deben coincidir con las guardadas)
+         * @param tree árbol leído (salida)
+         * @param cost coste leído (salida)
+         * @return true si hay una entrada válida para estos puntos y opciones
+         */
+        bool lookup(std::uint64_t key, const CyA::point_vector &points, const std::string &options,
+                    CyA::index_tree &tree, double &cost) const;
+
+        /**
+         * @brief Guarda el resultado (temporal + rename) y expulsa entradas si se supera el tamaño.
+         * @param key clave
+         * @param points puntos
+         * @param options opciones del motor
+         * @param tree árbol
+         * @param cost coste
+         * @param error mensaje de error (salida)
+         * @return false si no se pudo escribir
+         */
+        bool store(std::uint64_t key, const CyA::point_vector &points, const std::string &options,
+                   const CyA::index_tree &tree, double cost, std::string &error) const;
+
+    private:
+        /**
+         * @brief Ruta del fichero de la clave.
+         */
+        std::string path(std::uint64_t key) const;
+
+        /**
+         * @brief Borra las entradas más antiguas hasta quedar por debajo de max_bytes_.
+         */
+        void evict(void) const;
+    };
+}
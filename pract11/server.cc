@@ -0,0 +1,433 @@
+/**
+ * @file server.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación del modo servidor y del cliente.
+ */
+
+#include "server.h"
+#include "point_reader.h"
+#include "point_file.h"
+#include "output_writer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace EMST
+{
+    namespace
+    {
+        volatile std::sig_atomic_t stop_requested = 0;
+
+        // Extremo de escritura del self-pipe que despierta el poll() de serve()
+        volatile std::sig_atomic_t stop_pipe = -1;
+
+        /**
+         * @brief Manejador de SIGINT/SIGTERM: pide terminar y despierta el bucle de accept().
+         *
+         * El byte del pipe no se pierde aunque la señal llegue justo antes de
+         * poll(), al contrario que el EINTR de un accept() que aún no ha empezado.
+         */
+        void request_stop(int)
+        {
+            const int saved = errno;
+            stop_requested = 1;
+            if (stop_pipe >= 0)
+            {
+                const char byte = 0;
+                (void)!::write(stop_pipe, &byte, 1);
+            }
+            errno = saved;
+        }
+
+        /**
+         * @brief Dirección del socket Unix.
+         * @return false si la ruta no cabe en sun_path
+         */
+        bool make_address(const std::string &path, sockaddr_un &address, std::string &error)
+        {
+            std::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+
+            if (path.size() >= sizeof(address.sun_path))
+            {
+                error = path + ": ruta del socket demasiado larga";
+                return false;
+            }
+
+            std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+            return true;
+        }
+
+        /**
+         * @brief Lee hasta el final de la conexión reutilizando la capacidad de buffer.
+         *
+         * El plazo es para la petición entera: un cliente que envía poco a poco
+         * o que nunca cierra su escritura no retiene el hilo más de seconds segundos
+         * (sin plazo si seconds < 0).
+         * @return false si falla la lectura, se superan limit bytes (errno = EFBIG)
+         *         o se agota el plazo (errno = ETIMEDOUT)
+         */
+        bool read_until_eof(int fd, std::string &buffer, size_t limit, int seconds)
+        {
+            using clock = std::chrono::steady_clock;
+            const clock::time_point deadline = clock::now() + std::chrono::seconds(seconds);
+
+            size_t used = 0;
+            buffer.resize(std::max<size_t>(buffer.capacity(), 64 * 1024));
+
+            for (;;)
+            {
+                if (used == buffer.size())
+                {
+                    if (used >= limit)
+                    {
+                        errno = EFBIG;
+                        return false;
+                    }
+                    buffer.resize(std::min(2 * buffer.size(), limit + 1));
+                }
+
+                const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now());
+                const int timeout = seconds < 0 ? -1 : static_cast<int>(std::max<long long>(left.count(), 0));
+                pollfd readable = {fd, POLLIN, 0};
+                const int ready = timeout != 0 ? ::poll(&readable, 1, timeout) : 0;
+                if (ready < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (ready < 0)
+                {
+                    return false;
+                }
+                if (ready == 0)
+                {
+                    errno = ETIMEDOUT;
+                    return false;
+                }
+
+                const ssize_t r = ::read(fd, &buffer[used], buffer.size() - used);
+                if (r < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (r < 0)
+                {
+                    return false;
+                }
+                if (r == 0)
+                {
+                    break;
+                }
+
+                used += static_cast<size_t>(r);
+            }
+
+            buffer.resize(used);
+            return true;
+        }
+
+        /**
+         * @brief Escribe todo el texto (MSG_NOSIGNAL: un cliente que se va no mata al servidor).
+         */
+        bool send_all(int fd, const std::string &text)
+        {
+            const char *p = text.data();
+            size_t left = text.size();
+
+            while (left > 0)
+            {
+                const ssize_t w = ::send(fd, p, left, MSG_NOSIGNAL);
+                if (w < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (w < 0)
+                {
+                    return false;
+                }
+
+                p += w;
+                left -= static_cast<size_t>(w);
+            }
+
+            return true;
+        }
+    }
+
+    /**
+     * @brief Bucle de accept() en el hilo principal y cola de conexiones para los hilos.
+     * @param socket_path ruta del socket
+     * @param e motor
+     * @param workers número de hilos
+     * @param error mensaje de error (salida)
+     * @return false si no se pudo crear el socket
+     */
+    bool serve(const std::string &socket_path, engine e, int workers, std::string &error)
+    {
+        sockaddr_un address;
+        if (!make_address(socket_path, address, error))
+        {
+            return false;
+        }
+
+        // No bloqueante: si el cliente se va entre poll() y accept() no nos quedamos esperando
+        const int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+        if (listener < 0)
+        {
+            error = std::string("socket: ") + std::strerror(errno);
+            return false;
+        }
+
+        ::unlink(socket_path.c_str());
+        if (::bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+            ::listen(listener, SOMAXCONN) != 0)
+        {
+            error = socket_path + ": " + std::strerror(errno);
+            ::close(listener);
+            return false;
+        }
+
+        int wakeup[2];
+        if (::pipe2(wakeup, O_CLOEXEC | O_NONBLOCK) != 0)
+        {
+            error = std::string("pipe: ") + std::strerror(errno);
+            ::close(listener);
+            ::unlink(socket_path.c_str());
+            return false;
+        }
+
+        stop_requested = 0;
+        stop_pipe = wakeup[1];
+
+        struct sigaction action;
+        struct sigaction previous_int;
+        struct sigaction previous_term;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_handler = request_stop;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, &previous_int);
+        sigaction(SIGTERM, &action, &previous_term);
+
+        std::deque<int> pending;
+        std::mutex mutex;
+        std::condition_variable available;
+        bool closing = false;
+
+        // Cada hilo conserva sus búferes y su point_set entre peticiones
+        auto work = [&]() {
+            point_set ps(CyA::point_vector{});
+            CyA::point_vector points;
+            std::string request;
+            std::string response;
+            std::string message;
+
+            for (;;)
+            {
+                int client;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    available.wait(lock, [&]() { return closing || !pending.empty(); });
+                    if (pending.empty())
+                    {
+                        return;
+                    }
+                    client = pending.front();
+                    pending.pop_front();
+                }
+
+                response.clear();
+
+                if (!read_until_eof(client, request, SERVER_MAX_REQUEST_BYTES, SERVER_RECV_TIMEOUT))
+                {
+                    if (errno == EFBIG)
+                    {
+                        response = SERVER_ERROR_PREFIX "petición mayor que " +
+                                   std::to_string(SERVER_MAX_REQUEST_BYTES >> 20) + " MiB\n";
+                    }
+                    else if (errno == ETIMEDOUT)
+                    {
+                        response = SERVER_ERROR_PREFIX "la petición no se completó en " +
+                                   std::to_string(SERVER_RECV_TIMEOUT) + " s\n";
+                    }
+                    send_all(client, response);
+                }
+                else
+                {
+                    const char *begin = request.data();
+                    const char *end = begin + request.size();
+                    const bool binary = request.size() >= sizeof(POINT_FILE_MAGIC) &&
+                                        std::memcmp(begin, POINT_FILE_MAGIC, sizeof(POINT_FILE_MAGIC)) == 0;
+
+                    // Una petición que falla (memoria agotada incluida) solo afecta a su cliente
+                    try
+                    {
+                        points.clear();
+                        bool ok = binary ? decode_point_file(begin, end, points, message)
+                                         : parse_points(begin, end, points, message);
+
+                        if (ok && (e == engine::kruskal || e == engine::filter) &&
+                            points.size() > SERVER_QUADRATIC_LIMIT)
+                        {
+                            message = std::to_string(points.size()) + " puntos: el motor " + engine_name(e) +
+                                      " admite como mucho " + std::to_string(SERVER_QUADRATIC_LIMIT);
+                            ok = false;
+                        }
+
+                        if (ok)
+                        {
+                            ps.reset(std::move(points));
+                            ps.EMST(e);
+
+                            output_writer out(response);
+                            ps.write_tree(out);
+                            out.flush();
+
+                            // Recuperar el búfer de puntos para la siguiente petición
+                            points.swap(ps);
+                        }
+                        else
+                        {
+                            response = SERVER_ERROR_PREFIX + message + "\n";
+                        }
+                    }
+                    catch (const std::exception &ex)
+                    {
+                        ps.reset(CyA::point_vector{});
+                        CyA::point_vector().swap(points);
+                        response = std::string(SERVER_ERROR_PREFIX) + "no se pudo resolver la petición: " + ex.what() + "\n";
+                    }
+
+                    send_all(client, response);
+                }
+
+                ::close(client);
+            }
+        };
+
+        // Los hilos heredan la máscara con las señales bloqueadas: solo las
+        // recibe el hilo principal, que es el que está en poll()
+        sigset_t signals;
+        sigset_t previous;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, &previous);
+
+        workers = std::max(1, workers);
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (int w = 0; w < workers; ++w)
+        {
+            pool.emplace_back(work);
+        }
+
+        pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+
+        while (!stop_requested)
+        {
+            pollfd watched[2] = {{listener, POLLIN, 0}, {wakeup[0], POLLIN, 0}};
+            if (::poll(watched, 2, -1) < 0 || watched[1].revents != 0)
+            {
+                // EINTR o el byte del manejador: stop_requested decide
+                continue;
+            }
+
+            const int client = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client < 0)
+            {
+                // EAGAIN si el cliente ya se fue; otros errores (p. ej. EMFILE) son transitorios
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending.push_back(client);
+            }
+            available.notify_one();
+        }
+
+        // Terminar las peticiones ya aceptadas y cerrar
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        available.notify_all();
+
+        for (std::thread &t : pool)
+        {
+            t.join();
+        }
+
+        sigaction(SIGINT, &previous_int, nullptr);
+        sigaction(SIGTERM, &previous_term, nullptr);
+        stop_pipe = -1;
+        ::close(wakeup[0]);
+        ::close(wakeup[1]);
+        ::close(listener);
+        ::unlink(socket_path.c_str());
+        return true;
+    }
+
+    /**
+     * @brief Conecta, envía la petición, cierra la escritura y lee la respuesta.
+     * @param socket_path ruta del socket
+     * @param request puntos
+     * @param response respuesta (salida)
+     * @param error mensaje de error (salida)
+     * @return true si se recibió la respuesta
+     */
+    bool send_request(const std::string &socket_path, const std::string &request, std::string &response,
+                      std::string &error)
+    {
+        sockaddr_un address;
+        if (!make_address(socket_path, address, error))
+        {
+            return false;
+        }
+
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            error = std::string("socket: ") + std::strerror(errno);
+            return false;
+        }
+
+        bool ok = ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+        if (ok)
+        {
+            // Si el servidor rechaza la petición sin leerla entera (EPIPE) su respuesta
+            // de error sigue en el socket
+            const bool sent = send_all(fd, request) && ::shutdown(fd, SHUT_WR) == 0;
+            ok = (sent || errno == EPIPE) && read_until_eof(fd, response, static_cast<size_t>(-1) / 2, -1) &&
+                 (sent || !response.empty());
+            if (!sent && !ok)
+            {
+                errno = EPIPE;
+            }
+        }
+
+        if (!ok)
+        {
+            error = socket_path + ": " + std::strerror(errno);
+        }
+
+        ::close(fd);
+        return ok;
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file server.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Modo servidor: proceso residente que resuelve peticiones por un socket Unix.
+ *
+ * Protocolo: el cliente se conecta, envía un conjunto de puntos en el formato
+ * de texto "n / x y" o en el formato binario de point_file.h, cierra su lado
+ * de escritura y lee la respuesta hasta el final: la misma salida que
+ * write_tree (aristas y coste) o una línea "ERROR: ..." si la petición no es
+ * válida, supera SERVER_MAX_REQUEST_BYTES o SERVER_QUADRATIC_LIMIT puntos con
+ * un motor cuadrático, no termina de llegar en SERVER_RECV_TIMEOUT segundos,
+ * o no se puede resolver (p. ej. falta memoria). Cada hilo del servidor conserva entre peticiones sus búferes de
+ * entrada, de puntos y de salida y su point_set, de modo que una petición
+ * pequeña no paga el arranque del proceso ni las primeras reservas de memoria.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "point_set.h"
+
+#define SERVER_ERROR_PREFIX "ERROR: "
+
+// Tamaño máximo de una petición (bytes)
+#define SERVER_MAX_REQUEST_BYTES (256ull << 20)
+
+// Segundos que el servidor espera a recibir la petición completa
+#define SERVER_RECV_TIMEOUT 30
+
+// Puntos máximos por petición para los motores con n(n-1)/2 aristas (kruskal, filter)
+#define SERVER_QUADRATIC_LIMIT 10000
+
+namespace EMST
+{
+    /**
+     * @brief Atiende peticiones en socket_path con workers hilos hasta SIGINT o SIGTERM.
+     *
+     * Si el fichero del socket ya existe se sustituye; al terminar se borra.
+     * @param socket_path ruta del socket Unix
+     * @param e motor EMST
+     * @param workers número de hilos (peticiones atendidas a la vez)
+     * @param error mensaje de error (salida)
+     * @return false si no se pudo crear el socket
+     */
+    bool serve(const std::string &socket_path, engine e, int workers, std::string &error);
+
+    /**
+     * @brief Cliente: envía una petición y recibe la respuesta completa.
+     * @param socket_path ruta del socket Unix del servidor
+     * @param request puntos en formato de texto o binario
+     * @param response respuesta del servidor (salida)
+     * @param error mensaje de error (salida) si falla la comunicación
+     * @return true si se recibió una respuesta
+     */
+    bool send_request(const std::string &socket_path, const std::string &request, std::string &response,
+                      std::string &error);
+}
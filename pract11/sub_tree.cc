@@ -14,12 +14,50 @@
 
 namespace EMST
 {
+    /**
+     * @brief Constructor: recurso de memoria real sin reservas todavía.
+     * @param upstream recurso al que se reenvían las reservas
+     */
+    counting_resource::counting_resource(std::pmr::memory_resource *upstream) : upstream_(upstream),
+                                                                               allocations_(0),
+                                                                               bytes_(0)
+    {
+    }
+
+    /**
+     * @brief Reserva en upstream y la cuenta.
+     */
+    void *counting_resource::do_allocate(std::size_t bytes, std::size_t alignment)
+    {
+        ++allocations_;
+        bytes_ += bytes;
+
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    /**
+     * @brief Libera en upstream.
+     */
+    void counting_resource::do_deallocate(void *p, std::size_t bytes, std::size_t alignment)
+    {
+        upstream_->deallocate(p, bytes, alignment);
+    }
+
+    /**
+     * @brief Solo es igual a sí mismo (cada instancia lleva sus propios contadores).
+     */
+    bool counting_resource::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+    {
+        return this == &other;
+    }
+
     /**
      * @brief Constructor: inicializa contenedores y coste a 0.0
+     * @param resource recurso de memoria de la colección de puntos
      */
-    sub_tree::sub_tree(void) : arcs_(),
-                               points_(),
-                               cost_(0.0)
+    sub_tree::sub_tree(std::pmr::memory_resource *resource) : arcs_(),
+                                                              points_(resource),
+                                                              cost_(0.0)
     {
     }
 
@@ -72,15 +110,60 @@ namespace EMST
      */
     void sub_tree::merge(const sub_tree &st, const CyA::weigthed_arc &a)
     {
-        // Añadir todos los arcos del subárbol recibido
+        // Añadir todos los arcos del subárbol recibido y el arco que une ambos
         arcs_.insert(arcs_.end(), st.arcs_.begin(), st.arcs_.end());
-        // Añadir el arco que une ambos subárboles
         arcs_.push_back(a.second);
 
-        // Unir las colecciones de puntos
+        // Los puntos copiados se reservan en el recurso de este sub-árbol
         points_.insert(st.points_.begin(), st.points_.end());
 
+        cost_ += a.first + st.get_cost();
+    }
+
+    /**
+     * @brief Fusiona st (que queda vacío) volcando el menor de los dos en el mayor.
+     * @param st sub-árbol que se añadirá
+     * @param a arco ponderado que une ambos sub-árboles
+     */
+    void sub_tree::merge(sub_tree &&st, const CyA::weigthed_arc &a)
+    {
+        const bool same_resource = points_.get_allocator() == st.points_.get_allocator();
+
+        // Quedarse con el conjunto de puntos del mayor (intercambio O(1) con el mismo recurso)
+        if (same_resource && st.points_.size() > points_.size())
+        {
+            points_.swap(st.points_);
+        }
+
+        // Arcos propios, después los del subárbol recibido y el arco que une ambos.
+        // Si los propios son menos se colocan delante del vector de st (un solo
+        // desplazamiento de memoria) y ese vector pasa a ser el propio
+        if (arcs_.size() < st.arcs_.size())
+        {
+            st.arcs_.insert(st.arcs_.begin(), arcs_.begin(), arcs_.end());
+            arcs_.swap(st.arcs_);
+        }
+        else
+        {
+            arcs_.insert(arcs_.end(), st.arcs_.begin(), st.arcs_.end());
+        }
+        arcs_.push_back(a.second);
+
+        // Unir las colecciones de puntos: con el mismo recurso se trasladan los nodos
+        if (same_resource)
+        {
+            points_.merge(st.points_);
+        }
+        else
+        {
+            points_.insert(st.points_.begin(), st.points_.end());
+        }
+
         // Actualizar coste, con coste propio + coste del subárbol pasado + peso del arco que los une
         cost_ += a.first + st.get_cost();
+
+        st.arcs_.clear();
+        st.points_.clear();
+        st.cost_ = 0.0;
     }
 }
@@ -4,17 +4,59 @@
  * @brief Declaración de la clase sub_tree usada por Kruskal (subárboles).
  *
  * Implementa una estructura que contiene arcos, puntos contenidos y coste.
+ *
+ * Los puntos se guardan en un std::pmr::set: todos los sub_trees de un bosque
+ * pueden compartir un recurso de memoria (p. ej. un unsynchronized_pool_resource)
+ * y, como sus asignadores son iguales, una fusión traslada los nodos del
+ * conjunto menor al mayor (set::merge) sin reservar ni copiar nada.
  */
 
 #pragma once
 
 #include <iostream>
 #include <cmath>
+#include <cstddef>
+#include <memory_resource>
+#include <set>
 
 #include "point_types.h"
 
 namespace EMST
 {
+    /**
+     * @class counting_resource
+     * @brief Recurso de memoria que cuenta las reservas que pide a otro recurso.
+     */
+    class counting_resource : public std::pmr::memory_resource
+    {
+    private:
+        std::pmr::memory_resource *upstream_;
+        std::size_t allocations_;
+        std::size_t bytes_;
+
+    public:
+        /**
+         * @brief Cuenta las reservas hechas a upstream.
+         * @param upstream recurso real
+         */
+        explicit counting_resource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+        /**
+         * @brief Número de reservas realizadas.
+         */
+        inline std::size_t allocations(void) const { return allocations_; }
+
+        /**
+         * @brief Bytes reservados en total (sin descontar las liberaciones).
+         */
+        inline std::size_t bytes(void) const { return bytes_; }
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    };
+
     /**
      * @class sub_tree
      * @brief Representa un sub-árbol: contiene arcos, puntos y coste acumulado.
@@ -26,14 +68,24 @@ namespace EMST
     {
     private:
         CyA::tree arcs_;
-        CyA::point_collection points_;
+        std::pmr::set<CyA::point> points_;
         double cost_;
 
     public:
         /**
-         * @brief Constructor por defecto.
+         * @brief Constructor: sub-árbol vacío cuyos puntos se reservan en resource.
+         * @param resource recurso de memoria de la colección de puntos
+         */
+        explicit sub_tree(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+        sub_tree(const sub_tree &) = default;
+        sub_tree(sub_tree &&) = default;
+        sub_tree &operator=(const sub_tree &) = default;
+
+        /**
+         * @brief Asignación por movimiento (requiere el mismo recurso para no copiar nodos).
          */
-        sub_tree(void);
+        sub_tree &operator=(sub_tree &&) = default;
 
         /**
          * @brief Destructor.
@@ -60,13 +112,33 @@ namespace EMST
         bool contains(const CyA::point &p) const;
 
         /**
-         * @brief Fusiona el sub-árbol actual con otro sub-árbol pasado por referencia,
-         *        mediante el arco ponderado a.
+         * @brief Fusiona el sub-árbol actual con una copia de otro, mediante el arco ponderado a.
+         *
+         * Los puntos copiados se reservan en el recurso de memoria de este sub-árbol.
          * @param st sub-árbol que se añadirá
          * @param a arco ponderado que une ambos sub-árboles
          */
         void merge(const sub_tree &st, const CyA::weigthed_arc &a);
 
+        /**
+         * @brief Fusiona st en el sub-árbol actual mediante el arco ponderado a, vaciando st.
+         *
+         * El menor de los dos se vuelca en el mayor: cada punto cambia de
+         * conjunto O(log n) veces en toda la construcción de un bosque. Con el
+         * mismo recurso de memoria los nodos se trasladan sin reservas nuevas.
+         * Como en la otra sobrecarga, get_arcs() devuelve los arcos propios, los
+         * de st y por último a.
+         * @param st sub-árbol que se añadirá (queda vacío)
+         * @param a arco ponderado que une ambos sub-árboles
+         */
+        void merge(sub_tree &&st, const CyA::weigthed_arc &a);
+
+        /**
+         * @brief Número de puntos del sub-árbol.
+         * @return tamaño de la colección de puntos
+         */
+        inline std::size_t size(void) const { return points_.size(); }
+
         /**
          * @brief Devuelve los arcos del sub-árbol.
          * @return referencia constante al vector de arcos
@@ -0,0 +1,351 @@
+/**
+ * @file tiling.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de los trabajadores del EMST por franjas.
+ */
+
+#include "tiling.h"
+#include "point_file.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace EMST
+{
+    namespace
+    {
+        /**
+         * @brief Lee exactamente length bytes; false si la entrada termina antes.
+         */
+        bool read_all(int fd, void *data, std::size_t length)
+        {
+            char *p = static_cast<char *>(data);
+
+            while (length > 0)
+            {
+                const ssize_t r = ::read(fd, p, length);
+                if (r < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (r <= 0)
+                {
+                    return false;
+                }
+
+                p += r;
+                length -= static_cast<std::size_t>(r);
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Escribe exactamente length bytes.
+         */
+        bool write_all(int fd, const void *data, std::size_t length)
+        {
+            const char *p = static_cast<const char *>(data);
+
+            while (length > 0)
+            {
+                const ssize_t w = ::write(fd, p, length);
+                if (w < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (w < 0)
+                {
+                    return false;
+                }
+
+                p += w;
+                length -= static_cast<std::size_t>(w);
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Envía un conjunto como fichero binario de puntos (coordenadas double).
+         */
+        bool send_points(int fd, const CyA::point_vector &points)
+        {
+            point_file_header h;
+            std::memset(&h, 0, sizeof(h));
+            std::memcpy(h.magic, POINT_FILE_MAGIC, sizeof(POINT_FILE_MAGIC));
+            h.version = POINT_FILE_VERSION;
+            h.dimension = 2;
+            h.type = coord_type::float64;
+            h.count = points.size();
+
+            return write_all(fd, &h, sizeof(h)) &&
+                   write_all(fd, points.data(), points.size() * sizeof(CyA::point));
+        }
+
+        /**
+         * @brief Recibe una respuesta: número de aristas (menos que points) y pares de índices.
+         * @return false si la respuesta está incompleta o algún índice no es menor que points
+         */
+        bool receive_tree(int fd, std::size_t points, CyA::index_tree &tree)
+        {
+            std::uint64_t m;
+            if (!read_all(fd, &m, sizeof(m)) || m >= std::max<std::size_t>(points, 1))
+            {
+                return false;
+            }
+
+            tree.resize(static_cast<std::size_t>(m));
+            if (!read_all(fd, tree.data(), tree.size() * sizeof(CyA::index_arc)))
+            {
+                return false;
+            }
+
+            // El coordinador indexa con estos pares los puntos de la petición
+            return std::all_of(tree.begin(), tree.end(), [points](const CyA::index_arc &a)
+                               { return a.first < points && a.second < points; });
+        }
+    }
+
+    static_assert(sizeof(CyA::index_arc) == 2 * sizeof(std::uint32_t), "index_arc debe ser dos uint32 empaquetados");
+
+    /**
+     * @brief Lee peticiones hasta el final de la entrada; cada una se responde antes de leer la siguiente.
+     * @param in descriptor de entrada
+     * @param out descriptor de salida
+     * @param e motor
+     * @return false si una petición está incompleta o no es válida, o falla la escritura
+     */
+    bool run_tile_worker(int in, int out, engine e)
+    {
+        point_set ps(CyA::point_vector{});
+        CyA::point_vector points;
+        std::string request;
+        std::string error;
+
+        for (;;)
+        {
+            point_file_header h;
+            const ssize_t r = ::read(in, &h, sizeof(h));
+            if (r == 0)
+            {
+                return true;
+            }
+
+            // La cabecera puede llegar en varios trozos
+            if (r < 0 || (static_cast<std::size_t>(r) < sizeof(h) &&
+                          !read_all(in, reinterpret_cast<char *>(&h) + r, sizeof(h) - static_cast<std::size_t>(r))))
+            {
+                return false;
+            }
+
+            // Solo se aceptan las peticiones del coordinador: 2D y coordenadas double
+            if (std::memcmp(h.magic, POINT_FILE_MAGIC, sizeof(POINT_FILE_MAGIC)) != 0 || h.dimension != 2 ||
+                h.type != coord_type::float64)
+            {
+                return false;
+            }
+
+            const std::size_t payload = static_cast<std::size_t>(h.count) * sizeof(CyA::point);
+            request.resize(sizeof(h) + payload);
+            std::memcpy(&request[0], &h, sizeof(h));
+
+            if (!read_all(in, &request[sizeof(h)], payload) ||
+                !decode_point_file(request.data(), request.data() + request.size(), points, error))
+            {
+                return false;
+            }
+
+            ps.reset(std::move(points));
+            ps.EMST(e);
+
+            const CyA::index_tree &tree = ps.get_index_tree();
+            const std::uint64_t m = tree.size();
+            if (!write_all(out, &m, sizeof(m)) || !write_all(out, tree.data(), tree.size() * sizeof(CyA::index_arc)))
+            {
+                return false;
+            }
+
+            // Recuperar el búfer de puntos para la siguiente petición
+            points.swap(ps);
+        }
+    }
+
+    /**
+     * @brief Constructor: sin trabajadores.
+     */
+    tile_workers::tile_workers(void) : pids_(),
+                                       to_(),
+                                       from_(),
+                                       previous_sigpipe_(),
+                                       sigpipe_saved_(false)
+    {
+    }
+
+    /**
+     * @brief Destructor: cierra las tuberías y espera a los trabajadores.
+     */
+    tile_workers::~tile_workers(void)
+    {
+        stop();
+    }
+
+    /**
+     * @brief fork + exec de cada trabajador con su entrada y su salida redirigidas a tuberías.
+     * @param command programa y argumentos
+     * @param count número de trabajadores
+     * @param error mensaje de error (salida)
+     * @return false si falla pipe o fork
+     */
+    bool tile_workers::start(const std::vector<std::string> &command, int count, std::string &error)
+    {
+        stop();
+
+        // Un trabajador que muere no debe terminar el coordinador al escribirle: SIGPIPE
+        // se ignora (escrituras con EPIPE) solo mientras haya trabajadores
+        struct sigaction ignore;
+        std::memset(&ignore, 0, sizeof(ignore));
+        ignore.sa_handler = SIG_IGN;
+        sigemptyset(&ignore.sa_mask);
+        sigpipe_saved_ = sigaction(SIGPIPE, &ignore, &previous_sigpipe_) == 0;
+
+        std::vector<char *> argv;
+        for (const std::string &arg : command)
+        {
+            argv.push_back(const_cast<char *>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        for (int w = 0; w < count; ++w)
+        {
+            // O_CLOEXEC: cada trabajador solo hereda sus dos extremos (dup2 en 0 y 1)
+            int to[2];
+            int from[2];
+            if (pipe2(to, O_CLOEXEC) != 0)
+            {
+                error = std::string("pipe: ") + std::strerror(errno);
+                return false;
+            }
+            if (pipe2(from, O_CLOEXEC) != 0)
+            {
+                error = std::string("pipe: ") + std::strerror(errno);
+                ::close(to[0]);
+                ::close(to[1]);
+                return false;
+            }
+
+            const pid_t pid = fork();
+            if (pid == 0)
+            {
+                // Un SIG_IGN se hereda a través de exec
+                if (sigpipe_saved_)
+                {
+                    sigaction(SIGPIPE, &previous_sigpipe_, nullptr);
+                }
+                dup2(to[0], 0);
+                dup2(from[1], 1);
+                execvp(argv[0], argv.data());
+                _exit(127);
+            }
+
+            ::close(to[0]);
+            ::close(from[1]);
+
+            if (pid < 0)
+            {
+                error = std::string("fork: ") + std::strerror(errno);
+                ::close(to[1]);
+                ::close(from[0]);
+                return false;
+            }
+
+            pids_.push_back(pid);
+            to_.push_back(to[1]);
+            from_.push_back(from[0]);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Un hilo por trabajador toma el siguiente trabajo libre, lo envía y espera su árbol.
+     * @param jobs conjuntos de puntos
+     * @param trees árboles (salida)
+     * @param error mensaje de error (salida)
+     * @return false si algún trabajador falló
+     */
+    bool tile_workers::solve(const std::vector<CyA::point_vector> &jobs, std::vector<CyA::index_tree> &trees,
+                             std::string &error)
+    {
+        trees.assign(jobs.size(), CyA::index_tree());
+
+        std::atomic<std::size_t> next(0);
+        std::atomic<bool> failed(false);
+        std::mutex mutex;
+
+        auto work = [&](int w) {
+            for (std::size_t k = next++; k < jobs.size() && !failed; k = next++)
+            {
+                if (!send_points(to_[w], jobs[k]) || !receive_tree(from_[w], jobs[k].size(), trees[k]))
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    error = "el trabajador " + std::to_string(w) + " no respondió al trabajo " + std::to_string(k);
+                    failed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(pids_.size());
+        for (int w = 0; w < size(); ++w)
+        {
+            pool.emplace_back(work, w);
+        }
+
+        for (std::thread &t : pool)
+        {
+            t.join();
+        }
+
+        return !failed;
+    }
+
+    /**
+     * @brief Cierra la entrada de cada trabajador (termina su bucle) y espera su salida.
+     */
+    void tile_workers::stop(void)
+    {
+        for (int fd : to_)
+        {
+            ::close(fd);
+        }
+        for (int fd : from_)
+        {
+            ::close(fd);
+        }
+        for (pid_t pid : pids_)
+        {
+            waitpid(pid, nullptr, 0);
+        }
+
+        pids_.clear();
+        to_.clear();
+        from_.clear();
+
+        if (sigpipe_saved_)
+        {
+            sigaction(SIGPIPE, &previous_sigpipe_, nullptr);
+            sigpipe_saved_ = false;
+        }
+    }
+}
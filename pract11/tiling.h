@@ -0,0 +1,99 @@
+/**
+ * @file tiling.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Procesos trabajadores para el EMST por franjas (--tiles).
+ *
+ * Un trabajador es otro proceso "emst --tile-worker -a motor" que se comunica
+ * solo por su entrada y su salida estándar: cada petición es un conjunto de
+ * puntos en el formato binario de point_file.h y cada respuesta un uint64 con
+ * el número de aristas seguido de sus pares de índices (uint32) locales a la
+ * petición. Como el protocolo es un flujo de bytes, la orden que lanza el
+ * trabajador puede sustituirse por una que lo ejecute en otro nodo (ssh u
+ * otro lanzador) sin cambiar el coordinador.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <signal.h>
+#include <sys/types.h>
+
+#include "point_types.h"
+#include "point_set.h"
+
+// Puntos mínimos por franja de --tiles
+#define TILE_MIN_POINTS 1024
+
+namespace EMST
+{
+    /**
+     * @brief Bucle del trabajador: resuelve peticiones de in y responde en out hasta el final de in.
+     * @param in descriptor de entrada
+     * @param out descriptor de salida
+     * @param e motor EMST
+     * @return false si la entrada no es válida o falla la escritura
+     */
+    bool run_tile_worker(int in, int out, engine e);
+
+    /**
+     * @class tile_workers
+     * @brief Grupo de procesos trabajadores unidos al coordinador por tuberías.
+     */
+    class tile_workers
+    {
+    private:
+        std::vector<pid_t> pids_;
+        std::vector<int> to_;   // extremo de escritura hacia cada trabajador
+        std::vector<int> from_; // extremo de lectura desde cada trabajador
+
+        // Acción de SIGPIPE anterior a start; se restaura en stop
+        struct sigaction previous_sigpipe_;
+        bool sigpipe_saved_;
+
+    public:
+        /**
+         * @brief Constructor: sin trabajadores.
+         */
+        tile_workers(void);
+
+        /**
+         * @brief Destructor: cierra las tuberías y espera a los trabajadores.
+         */
+        ~tile_workers(void);
+
+        tile_workers(const tile_workers &) = delete;
+        tile_workers &operator=(const tile_workers &) = delete;
+
+        /**
+         * @brief Lanza count procesos con la orden dada.
+         * @param command programa y argumentos (se busca en PATH si no lleva '/')
+         * @param count número de trabajadores
+         * @param error mensaje de error (salida)
+         * @return false si no se pudo crear algún proceso
+         */
+        bool start(const std::vector<std::string> &command, int count, std::string &error);
+
+        /**
+         * @brief Número de trabajadores lanzados.
+         */
+        inline int size(void) const { return static_cast<int>(pids_.size()); }
+
+        /**
+         * @brief Reparte los trabajos entre los trabajadores y recoge sus árboles.
+         * @param jobs conjuntos de puntos
+         * @param trees árbol de cada trabajo, con índices locales (salida)
+         * @param error mensaje de error (salida)
+         * @return false si algún trabajador falló
+         */
+        bool solve(const std::vector<CyA::point_vector> &jobs, std::vector<CyA::index_tree> &trees,
+                   std::string &error);
+
+    private:
+        /**
+         * @brief Cierra las tuberías y espera a que terminen los procesos.
+         */
+        void stop(void);
+    };
+}
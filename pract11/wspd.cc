@@ -0,0 +1,108 @@
+/**
+ * @file wspd.cc
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Implementación de la descomposición en pares bien separados.
+ */
+
+#include "wspd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace EMST
+{
+    /**
+     * @brief Constructor: kd-tree con un punto por hoja y s = 4(2 + ε)/ε.
+     * @param points vector de puntos
+     * @param epsilon error relativo admitido
+     */
+    wspd::wspd(const CyA::point_vector &points, double epsilon) : points_(points),
+                                                                  tree_(points, 1),
+                                                                  separation_(4.0 * (2.0 + epsilon) / epsilon)
+    {
+    }
+
+    /**
+     * @brief Destructor vacío.
+     */
+    wspd::~wspd(void)
+    {
+    }
+
+    /**
+     * @brief Recorre los nodos internos emparejando sus dos hijos.
+     * @param av vector a rellenar con una arista por par
+     */
+    void wspd::get_edges(CyA::index_arc_vector &av) const
+    {
+        const std::vector<kd_node> &nodes = tree_.get_nodes();
+
+        av.clear();
+
+        for (const kd_node &node : nodes)
+        {
+            if (!node.is_leaf())
+            {
+                find_pairs(node.left, node.right, av);
+            }
+        }
+    }
+
+    /**
+     * @brief Radio del círculo envolvente: media diagonal de la caja.
+     * @param node índice del nodo
+     * @return radio
+     */
+    double wspd::radius(int node) const
+    {
+        const kd_node &n = tree_.get_nodes()[node];
+
+        return 0.5 * std::hypot(n.max_x - n.min_x, n.max_y - n.min_y);
+    }
+
+    /**
+     * @brief Emite el par (a, b) si está bien separado; si no, divide el nodo mayor.
+     * @param a primer nodo
+     * @param b segundo nodo
+     * @param av aristas emitidas
+     */
+    void wspd::find_pairs(int a, int b, CyA::index_arc_vector &av) const
+    {
+        const std::vector<kd_node> &nodes = tree_.get_nodes();
+        const kd_node &na = nodes[a];
+        const kd_node &nb = nodes[b];
+
+        const double ra = radius(a);
+        const double rb = radius(b);
+
+        const double dx = 0.5 * ((na.min_x + na.max_x) - (nb.min_x + nb.max_x));
+        const double dy = 0.5 * ((na.min_y + na.max_y) - (nb.min_y + nb.max_y));
+        const double gap = std::hypot(dx, dy) - ra - rb;
+
+        // Dos hojas (un punto cada una) siempre están bien separadas
+        if (gap >= separation_ * std::max(ra, rb) || (na.is_leaf() && nb.is_leaf()))
+        {
+            const int i = tree_.get_index()[na.begin];
+            const int j = tree_.get_index()[nb.begin];
+
+            const double ex = points_[i].first - points_[j].first;
+            const double ey = points_[i].second - points_[j].second;
+
+            av.emplace_back(ex * ex + ey * ey, std::min(i, j), std::max(i, j));
+            return;
+        }
+
+        // Dividir el nodo de mayor radio (una hoja no se puede dividir)
+        if (nb.is_leaf() || (!na.is_leaf() && ra >= rb))
+        {
+            find_pairs(na.left, b, av);
+            find_pairs(na.right, b, av);
+        }
+        else
+        {
+            find_pairs(a, nb.left, av);
+            find_pairs(a, nb.right, av);
+        }
+    }
+}
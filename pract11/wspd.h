@@ -0,0 +1,67 @@
+/**
+ * @file wspd.h
+ * @author Daniel Palenzuela Álvarez alu0101140469
+ * @brief Descomposición en pares bien separados (WSPD) para el EMST aproximado.
+ *
+ * Dos nodos del kd-tree están bien separados con factor s si la distancia entre
+ * sus círculos envolventes es al menos s veces el mayor de los radios. Una
+ * arista entre representantes de cada par forma un t-spanner con
+ * t = (s + 4) / (s - 4); con s = 4(2 + ε)/ε se obtiene t = 1 + ε y el MST del
+ * spanner cuesta como mucho (1 + ε) veces el EMST.
+ */
+
+#pragma once
+
+#include "point_types.h"
+#include "kd_tree.h"
+
+namespace EMST
+{
+    /**
+     * @class wspd
+     * @brief Pares bien separados sobre un kd-tree de hojas de un punto.
+     */
+    class wspd
+    {
+    private:
+        const CyA::point_vector &points_;
+        kd_tree tree_;
+        double separation_;
+
+    public:
+        /**
+         * @brief Prepara la descomposición para el error relativo epsilon.
+         * @param points vector de puntos (se guarda una referencia)
+         * @param epsilon error relativo admitido en el coste (> 0)
+         */
+        wspd(const CyA::point_vector &points, double epsilon);
+
+        /**
+         * @brief Destructor.
+         */
+        ~wspd(void);
+
+        /**
+         * @brief Una arista (distancia al cuadrado, i, j) por cada par bien separado.
+         * @param av vector a rellenar (sin ordenar)
+         */
+        void get_edges(CyA::index_arc_vector &av) const;
+
+        /**
+         * @brief Factor de separación usado.
+         * @return s = 4(2 + ε)/ε
+         */
+        inline double separation(void) const { return separation_; }
+
+    private:
+        /**
+         * @brief Empareja recursivamente los nodos a y b hasta que estén bien separados.
+         */
+        void find_pairs(int a, int b, CyA::index_arc_vector &av) const;
+
+        /**
+         * @brief Radio del círculo que envuelve la caja del nodo.
+         */
+        double radius(int node) const;
+    };
+}